@@ -0,0 +1,414 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_bench.c
+* @版本		V1.0.2
+* @日期
+* @概要		解析器热点路径基准测试, 结果以 JSON 格式输出
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "libserial_parse_text.h"
+
+#define BENCH_DATA_SIZE		(1024 * 1024)	// 每个场景的输入数据长度
+#define BENCH_CHANNELS		8				// 多通道场景的通道数
+#define BENCH_PIECE			64				// 多通道场景每次输入的数据长度
+
+// 被测接口
+enum {
+	BENCH_API_TEXT = 0,		// 逐字节 libserial_parse_text()
+	BENCH_API_TEXT_NL,		// 逐字节 libserial_parse_text_nl()
+	BENCH_API_FEED,			// 数据块 libserial_parse_feed()
+	BENCH_API_FEED_NL,		// 数据块 libserial_parse_feed_nl()
+	BENCH_API_PUSH,			// 数据块 libserial_parse_push()
+	BENCH_API_PUSH_NL,		// 数据块 libserial_parse_push_nl()
+	BENCH_API_MAX,
+};
+
+static const char *bench_api_name[BENCH_API_MAX] = {"text", "text_nl", "feed", "feed_nl", "push", "push_nl"};
+
+// 测试场景
+typedef struct {
+	const char *name;			// 场景名称
+	unsigned int space;			// 解析器可存储最长文本的长度
+	char shift;					// 大小写转换
+	const char *divide;			// 分隔字符集合
+	const char *ignore;			// 忽略字符集合
+	void (*make)(char *data, unsigned int size);	// 生成输入数据
+}bench_case_t;
+
+// 测试结果
+typedef struct {
+	unsigned long long bytes;	// 处理的字节数
+	unsigned long long tokens;	// 得到的文本个数
+	double seconds;				// 耗时
+}bench_result_t;
+
+static unsigned int bench_seed = 0x12345678;
+static volatile unsigned long long bench_sink = 0;
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_rand
+*	功能:	生成可复现的伪随机数
+*---------------------------------------------------------------------*/
+static unsigned int bench_rand(void)
+{
+	bench_seed = bench_seed * 1103515245 + 12345;
+	return (bench_seed >> 16) & 0x7fff;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_now
+*	功能:	获取单调时钟的当前时间(秒)
+*---------------------------------------------------------------------*/
+static double bench_now(void)
+{
+	struct timespec ts;
+#if defined(_WIN32)
+	timespec_get(&ts, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_fill
+*	功能:	从文本列表中随机选择文本重复填满数据区
+*---------------------------------------------------------------------*/
+static void bench_fill(char *data, unsigned int size, const char **list, unsigned int count)
+{
+	unsigned int i = 0x00, n = 0x00;
+	const char *s = NULL;
+
+	while(i < size){
+		s = list[bench_rand() % count];
+		n = (unsigned int)strlen(s);
+		n = (n < size - i) ? n : size - i;
+		memcpy(data + i, s, n);
+		i += n;
+	}
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_make_short
+*	功能:	短命令: 常见的串口命令行
+*---------------------------------------------------------------------*/
+static void bench_make_short(char *data, unsigned int size)
+{
+	static const char *list[] = {
+		"reboot\r\n", "reg_r 0x01,0x02,0x05,0x06\r\n", "reg_w 0x01=0x20, 0x02= 0x15\r\n",
+		"video udp,192.168.1.115,8000\r\n", "wifi \"my wifi\",12345678\r\n", "AT+CSQ\r\n",
+	};
+	bench_fill(data, size, list, sizeof(list) / sizeof(list[0]));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_make_long
+*	功能:	长文本: 每行 200~480 字节的日志
+*---------------------------------------------------------------------*/
+static void bench_make_long(char *data, unsigned int size)
+{
+	unsigned int i = 0x00, n = 0x00, end = 0x00;
+
+	while(i < size){
+		end = i + 200 + bench_rand() % 280;
+		for(n = i; n < end && n < size; n++){
+			data[n] = (bench_rand() % 8) ? (char)('a' + bench_rand() % 26) : ' ';
+		}
+		if(n < size){
+			data[n++] = '\n';
+		}
+		i = n;
+	}
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_make_quote
+*	功能:	大量双引号: 引号内包含空格和分隔字符
+*---------------------------------------------------------------------*/
+static void bench_make_quote(char *data, unsigned int size)
+{
+	static const char *list[] = {
+		"set \"ssid\" \"my wifi\"\n", "echo \"a,b\" \"c=d\" \"\"\n", "\"k\"=\"v\",\"x y\"\n",
+		"name \"\\\"q\\\"\" \"1 2 3\"\n",
+	};
+	bench_fill(data, size, list, sizeof(list) / sizeof(list[0]));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_make_ignore
+*	功能:	大量忽略字符: 字段间夹杂空格和制表符
+*---------------------------------------------------------------------*/
+static void bench_make_ignore(char *data, unsigned int size)
+{
+	static const char *list[] = {
+		"  a \t b\t\t,  c  ,\t d \n", "\t\t  key \t = \t value  \n", " 1 , 2 , 3 , 4 , 5 \n",
+		"    \t    \n",
+	};
+	bench_fill(data, size, list, sizeof(list) / sizeof(list[0]));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_make_shift
+*	功能:	大小写混合: 启用大小写转换
+*---------------------------------------------------------------------*/
+static void bench_make_shift(char *data, unsigned int size)
+{
+	static const char *list[] = {
+		"SetMode ON\r\n", "Reg_W 0x1A=0xFF\r\n", "VIDEO Udp,Host.Example.COM,8000\r\n",
+		"AT+CWJAP=\"MyAP\",\"PassWord\"\r\n",
+	};
+	bench_fill(data, size, list, sizeof(list) / sizeof(list[0]));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_make_overflow
+*	功能:	缓冲区溢出: 文本长度远超缓冲区
+*---------------------------------------------------------------------*/
+static void bench_make_overflow(char *data, unsigned int size)
+{
+	unsigned int i = 0x00;
+
+	for(i = 0; i < size; i++){
+		data[i] = (i % 1000 == 999) ? '\n' : (char)('a' + i % 26);
+	}
+}
+
+static const bench_case_t bench_cases[] = {
+	{"short_commands",	128,	LIBSERIAL_PARSE_SHIFT_NORMAL,	" ,=\n",	"\r",		bench_make_short},
+	{"long_lines",		512,	LIBSERIAL_PARSE_SHIFT_NORMAL,	" \n",		"\r",		bench_make_long},
+	{"quote_heavy",		128,	LIBSERIAL_PARSE_SHIFT_NORMAL,	" ,=\n",	"\r",		bench_make_quote},
+	{"ignore_heavy",	128,	LIBSERIAL_PARSE_SHIFT_NORMAL,	",=\n",		" \t\r",	bench_make_ignore},
+	{"shift",			128,	LIBSERIAL_PARSE_SHIFT_LOWER,	" ,=\n",	"\r",		bench_make_shift},
+	{"overflow",		64,		LIBSERIAL_PARSE_SHIFT_NORMAL,	" \n",		"\r",		bench_make_overflow},
+};
+
+// 回调接口的统计上下文
+typedef struct {
+	unsigned long long tokens;	// 得到的文本个数
+	unsigned long long sum;		// 文本长度之和
+}bench_count_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_on_token
+*	功能:	回调接口的文本回调, 只做计数
+*---------------------------------------------------------------------*/
+static int bench_on_token(void *ctx, const char *ptr, unsigned int len, char delimiter)
+{
+	bench_count_t *cnt = (bench_count_t *)ctx;
+	(void)ptr;
+	(void)delimiter;
+	cnt->tokens++;
+	cnt->sum += len;
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_pass
+*	功能:	使用指定接口解析一遍数据
+*	返回:	得到的文本个数
+*---------------------------------------------------------------------*/
+static unsigned long long bench_pass(libserial_parse_buf_t *spbuf, int api, const char *data, unsigned int size)
+{
+	unsigned long long tokens = 0x00, sum = 0x00;
+	unsigned int i = 0x00, len = 0x00, used = 0x00;
+	bench_count_t cnt = {0, 0};
+	libserial_parse_handler_t handler = {bench_on_token, NULL, &cnt};
+
+	switch(api){
+	case BENCH_API_TEXT:
+		for(i = 0; i < size; i++){
+			if((len = libserial_parse_text(spbuf, data[i])) > 0){
+				tokens++;
+				sum += len;
+			}
+		}
+		break;
+	case BENCH_API_TEXT_NL:
+		for(i = 0; i < size; i++){
+			if((len = libserial_parse_text_nl(spbuf, data[i])) > 0){
+				tokens++;
+				sum += len;
+			}
+		}
+		break;
+	case BENCH_API_FEED:
+		for(i = 0; i < size; i += used){
+			if((len = libserial_parse_feed(spbuf, data + i, size - i, &used)) > 0){
+				tokens++;
+				sum += len;
+			}
+		}
+		break;
+	case BENCH_API_FEED_NL:
+		for(i = 0; i < size; i += used){
+			if((len = libserial_parse_feed_nl(spbuf, data + i, size - i, &used)) > 0){
+				tokens++;
+				sum += len;
+			}
+		}
+		break;
+	case BENCH_API_PUSH:
+		libserial_parse_push(spbuf, &handler, data, size, NULL);
+		tokens = cnt.tokens;
+		sum = cnt.sum;
+		break;
+	default:
+		libserial_parse_push_nl(spbuf, &handler, data, size, NULL);
+		tokens = cnt.tokens;
+		sum = cnt.sum;
+		break;
+	}
+
+	bench_sink += sum;
+	return tokens;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_run_case
+*	功能:	重复解析直到达到最短测试时间
+*---------------------------------------------------------------------*/
+static bench_result_t bench_run_case(const bench_case_t *bc, int api, const char *data, unsigned int size, double min_time)
+{
+	libserial_parse_buf_t *spbuf = libserial_parse_create(bc->space);
+	bench_result_t res = {0, 0, 0.0};
+	double start = 0.0;
+
+	if(NULL == spbuf || 0 == libserial_parse_init(spbuf)){
+		libserial_parse_release(spbuf);
+		return res;
+	}
+	libserial_parse_set_divide_set(spbuf, bc->divide);
+	libserial_parse_set_ignore_set(spbuf, bc->ignore);
+	libserial_parse_set_shift(spbuf, bc->shift);
+
+	start = bench_now();
+	do{
+		res.tokens += bench_pass(spbuf, api, data, size);
+		res.bytes  += size;
+		res.seconds = bench_now() - start;
+	}while(res.seconds < min_time);
+
+	libserial_parse_release(spbuf);
+	return res;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_run_channels
+*	功能:	多通道场景: 各通道的数据按 BENCH_PIECE 字节交替到达
+*	参数:	use_pool: 非 0 时使用多通道解析器池, 为 0 时每个通道使用独立的解析器
+*			data: 每个通道的输入数据  size: 数据长度  min_time: 最短运行时间(秒)
+*---------------------------------------------------------------------*/
+static bench_result_t bench_run_channels(int use_pool, const char *data, unsigned int size, double min_time)
+{
+	libserial_parse_buf_t *spbuf[BENCH_CHANNELS] = {NULL};
+	libserial_parse_pool_t *pool = NULL;
+	bench_result_t res = {0, 0, 0.0};
+	unsigned int ch = 0x00, off = 0x00, n = 0x00, i = 0x00, used = 0x00, len = 0x00;
+	unsigned long long sum = 0x00;
+	double start = 0.0;
+
+	if(use_pool){
+		if((pool = libserial_parse_pool_create(BENCH_CHANNELS, 128)) == NULL || 0 == libserial_parse_pool_init(pool)){
+			libserial_parse_pool_release(pool);
+			return res;
+		}
+	}
+	for(ch = 0; !use_pool && ch < BENCH_CHANNELS; ch++){
+		if((spbuf[ch] = libserial_parse_create(128)) == NULL || 0 == libserial_parse_init(spbuf[ch])){
+			goto out;
+		}
+	}
+
+	start = bench_now();
+	do{
+		for(off = 0; off < size; off += n){
+			n = (BENCH_PIECE < size - off) ? BENCH_PIECE : size - off;
+			for(ch = 0; ch < BENCH_CHANNELS; ch++){
+				for(i = 0; i < n; i += used){
+					len = use_pool ? libserial_parse_pool_feed_nl(pool, ch, data + off + i, n - i, &used)
+								   : libserial_parse_feed_nl(spbuf[ch], data + off + i, n - i, &used);
+					if(len > 0){
+						res.tokens++;
+						sum += len;
+					}
+				}
+			}
+		}
+		res.bytes  += (unsigned long long)size * BENCH_CHANNELS;
+		res.seconds = bench_now() - start;
+	}while(res.seconds < min_time);
+	bench_sink += sum;
+
+out:
+	for(ch = 0; ch < BENCH_CHANNELS; ch++){
+		libserial_parse_release(spbuf[ch]);
+	}
+	libserial_parse_pool_release(pool);
+	return res;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	bench_print
+*	功能:	输出一条 JSON 格式的测试结果
+*---------------------------------------------------------------------*/
+static void bench_print(const char *name, const char *api, const bench_result_t *res, int first)
+{
+	double bps = (res->seconds > 0) ? (double)res->bytes / res->seconds : 0.0;
+	double nspt = (res->tokens > 0) ? res->seconds * 1e9 / (double)res->tokens : 0.0;
+
+	printf("%s\n    {\"case\": \"%s\", \"api\": \"%s\", \"bytes\": %llu, \"tokens\": %llu, "
+		   "\"seconds\": %.6f, \"bytes_per_sec\": %.0f, \"ns_per_token\": %.2f}",
+		   first ? "" : ",", name, api, res->bytes, res->tokens, res->seconds, bps, nspt);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	main
+*	功能:	用法: serial_parse_bench [最短测试时间(秒), 默认 0.2]
+*---------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+	double min_time = (argc > 1) ? atof(argv[1]) : 0.2;
+	unsigned int c = 0x00;
+	bench_result_t res;
+	char *data = NULL;
+	int api = 0x00, first = 1;
+
+	if((data = (char *)malloc(BENCH_DATA_SIZE)) == NULL){
+		fprintf(stderr, "malloc failed.\n");
+		return -1;
+	}
+
+	printf("{\n  \"benchmark\": \"libserial_parse_text\",\n  \"data_size\": %u,\n  \"min_time\": %.3f,\n  \"results\": [",
+		   BENCH_DATA_SIZE, min_time);
+
+	for(c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); c++){
+		bench_seed = 0x12345678;
+		bench_cases[c].make(data, BENCH_DATA_SIZE);
+		for(api = 0; api < BENCH_API_MAX; api++){
+			res = bench_run_case(&bench_cases[c], api, data, BENCH_DATA_SIZE, min_time);
+			bench_print(bench_cases[c].name, bench_api_name[api], &res, first);
+			first = 0;
+		}
+	}
+
+	bench_seed = 0x12345678;
+	bench_make_short(data, BENCH_DATA_SIZE);
+	res = bench_run_channels(0, data, BENCH_DATA_SIZE, min_time);
+	bench_print("multi_channel", "feed_nl", &res, first);
+	res = bench_run_channels(1, data, BENCH_DATA_SIZE, min_time);
+	bench_print("multi_channel", "pool_feed_nl", &res, first);
+
+	printf("\n  ],\n  \"checksum\": %llu\n}\n", bench_sink);
+	free(data);
+	return 0;
+}
@@ -1,5 +1,15 @@
 ﻿#include <stdio.h>
+#include <string.h>
 #include "libserial_parse_text.h"
+#include "libserial_parse_cmd.h"
+#if !defined(_WIN32)
+#include "libserial_parse_file.h"
+#endif
+#if defined(__linux__)
+#include <pty.h>
+#include <unistd.h>
+#include "libserial_parse_serial.h"
+#endif
 
 #define iprintf(format,...) 	printf("[inf]%s():%05d " format , __func__, __LINE__,##__VA_ARGS__)
 
@@ -49,7 +59,7 @@ int dynamic_mem_newline_example(const char* string)
 *---------------------------------------------------------------------*/
 int static_mem_newline_example(const char* string)
 {
-	char buff[512] = { 0 };
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
 	libserial_parse_buf_t spbuf;
 	unsigned int len = 0x00, i = 0x00;
 
@@ -85,7 +95,7 @@ int static_mem_newline_example(const char* string)
 *---------------------------------------------------------------------*/
 int static_mem_divide_example(const char* string)
 {
-	char buff[512] = { 0 };
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
 	libserial_parse_buf_t spbuf;
 	unsigned int len = 0x00, i = 0x00;
 
@@ -121,6 +131,259 @@ int static_mem_divide_example(const char* string)
 	return 0;
 }
 
+/*---------------------------------------------------------------------
+*	函数: 	static_mem_divide_set_example
+*	功能:	静态内存版本以分隔字符集合一次性解析命令和参数的示例代码
+*---------------------------------------------------------------------*/
+int static_mem_divide_set_example(const char* string)
+{
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
+	libserial_parse_buf_t spbuf;
+	unsigned int len = 0x00, i = 0x00;
+
+	// 指定静态内存
+	spbuf.buf = buff;
+	spbuf.total = sizeof(buff);
+
+	// 初始化缓冲区
+	if ((len = libserial_parse_init(&spbuf)) == 0x00) {
+		printf("memory is too small.\n");
+		return -1;
+	}
+
+	// 命令格式假定:  命令名称 地址1=数值1, 地址2=数值2
+	libserial_parse_set_divide_set(&spbuf, " ,=");	// 空格、逗号和等号都可以分隔文本
+	libserial_parse_set_ignore_set(&spbuf, "\t");	// 忽略制表符
+
+	// 开始解析字符串
+	printf("total:%d  len:%d\n", spbuf.total, len);
+	for (i = 0; i < strlen(string); i++) {
+		if ((len = libserial_parse_text(&spbuf, string[i])) > 0) {
+			printf("[parse] : %-2d->[%s] divide:'%c'\n", len, spbuf.buf, libserial_parse_get_divide(&spbuf));
+		}
+	}
+
+	// 检查是否还有剩下的字符串
+	if ((len = libserial_parse_text_finish(&spbuf)) > 0) {
+		printf("[finish]: %-2d->[%s]\n", len, spbuf.buf);
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	block_feed_newline_example
+*	功能:	以数据块方式批量解析以行为分割符的示例代码
+*---------------------------------------------------------------------*/
+int block_feed_newline_example(const char* string)
+{
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
+	libserial_parse_buf_t spbuf;
+	unsigned int len = 0x00, used = 0x00, size = strlen(string);
+
+	// 指定静态内存
+	spbuf.buf = buff;
+	spbuf.total = sizeof(buff);
+
+	// 初始化缓冲区
+	if ((len = libserial_parse_init(&spbuf)) == 0x00) {
+		printf("memory is too small.\n");
+		return -1;
+	}
+
+	// 模拟一次性收到的整块数据, 每解析出一行就从消耗位置继续
+	printf("total:%d  len:%d\n", spbuf.total, len);
+	while (size > 0) {
+		if ((len = libserial_parse_feed_nl(&spbuf, string, size, &used)) > 0) {
+			printf("[parse] : %-2d->[%s]\n", len, spbuf.buf);
+		}
+		string += used;
+		size -= used;
+	}
+
+	// 检查是否还有剩下的字符串
+	if ((len = libserial_parse_text_finish(&spbuf)) > 0) {
+		printf("[finish]: %-2d->[%s]\n", len, spbuf.buf);
+	}
+
+	return 0;
+}
+
+#ifdef LIBSERIAL_PARSE_FILTER
+/*---------------------------------------------------------------------
+*	函数: 	block_filter_newline_example
+*	功能:	以数据块方式批量解析以行为分割符的文本, 只保留包含关键字的行
+*---------------------------------------------------------------------*/
+int block_filter_newline_example(const char* string)
+{
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
+	unsigned int mem[128] = { 0 };
+	libserial_parse_buf_t spbuf;
+	libserial_parse_filter_t filter;
+	const libserial_parse_pattern_t patterns[] = { {"reg_", 1}, {"wifi", 0} };
+	unsigned int len = 0x00, used = 0x00, size = strlen(string);
+
+	// 指定静态内存
+	spbuf.buf = buff;
+	spbuf.total = sizeof(buff);
+
+	// 初始化缓冲区并挂接行过滤器(以 reg_ 开头或包含 wifi 的行)
+	if ((len = libserial_parse_init(&spbuf)) == 0x00) {
+		printf("memory is too small.\n");
+		return -1;
+	}
+	if (libserial_parse_filter_build(&filter, patterns, 2, mem, sizeof(mem)) == 0x00) {
+		printf("filter memory is too small, need %d bytes.\n", libserial_parse_filter_size(patterns, 2));
+		return -1;
+	}
+	libserial_parse_set_filter(&spbuf, &filter);
+
+	// 不匹配的行被直接跳过, 返回的行附带匹配到的关键字编号
+	while (size > 0) {
+		if ((len = libserial_parse_feed_nl(&spbuf, string, size, &used)) > 0) {
+			printf("[match %d]: %-2d->[%s]\n", libserial_parse_get_match(&spbuf), len, spbuf.buf);
+		}
+		string += used;
+		size -= used;
+	}
+
+	if ((len = libserial_parse_text_finish(&spbuf)) > 0) {
+		printf("[finish %d]: %-2d->[%s]\n", libserial_parse_get_match(&spbuf), len, spbuf.buf);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(LIBSERIAL_PARSE_FILTER) && !defined(_WIN32)
+// 解析结果摘要
+typedef struct {
+	unsigned int count;		// 文本个数
+	unsigned int hash;		// 依次累计所有文本的哈希值
+}parallel_digest_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	parallel_digest_line
+*	功能:	将一个文本累计到解析结果摘要中
+*---------------------------------------------------------------------*/
+static int parallel_digest_line(void *ctx, const char *line, unsigned int len)
+{
+	parallel_digest_t *digest = (parallel_digest_t *)ctx;
+	unsigned int i = 0x00;
+
+	for (i = 0; i < len; i++) {
+		digest->hash = (digest->hash ^ (unsigned char)line[i]) * 16777619u;
+	}
+	digest->hash = (digest->hash ^ '\n') * 16777619u;
+	digest->count++;
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	parallel_filter_newline_example
+*	功能:	多线程解析挂接了行过滤器的大块文本, 并与单线程解析的结果比较
+*---------------------------------------------------------------------*/
+int parallel_filter_newline_example(void)
+{
+	static char data[3 * 1024 * 1024];
+	const char *lines[] = { "reg_w 0x01=0x20", "temp=21", "video udp,wifi", "ack reg_r 0x01", "reboot" };
+	const libserial_parse_pattern_t patterns[] = { {"reg_", 1}, {"wifi", 0} };
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
+	unsigned int mem[128] = { 0 };
+	libserial_parse_buf_t spbuf;
+	libserial_parse_filter_t filter;
+	libserial_parse_span_t span;
+	parallel_digest_t par = { 0, 2166136261u }, seq = { 0, 2166136261u };
+	unsigned int len = 0x00, used = 0x00, size = 0x00, n = 0x00;
+
+	// 构造跨越多个数据块的文本, 其中夹杂超出缓冲区的长行
+	while (size + sizeof(buff) + 32 < sizeof(data)) {
+		if (0 == n % 1000) {
+			memset(data + size, 'x', sizeof(buff) + 16);
+			memcpy(data + size + sizeof(buff), "wifi", 4);
+			size += sizeof(buff) + 16;
+		}
+		size += sprintf(data + size, "%s %u\n", lines[n % 5], n);
+		n++;
+	}
+
+	spbuf.buf = buff;
+	spbuf.total = sizeof(buff);
+	if (libserial_parse_init(&spbuf) == 0x00) {
+		printf("memory is too small.\n");
+		return -1;
+	}
+	if (libserial_parse_filter_build(&filter, patterns, 2, mem, sizeof(mem)) == 0x00) {
+		printf("filter memory is too small, need %d bytes.\n", libserial_parse_filter_size(patterns, 2));
+		return -1;
+	}
+
+	// 各线程的私有解析器共享同一个行过滤器
+	libserial_parse_set_filter(&spbuf, &filter);
+	if (libserial_parse_parallel(&spbuf, data, size, 4, parallel_digest_line, &par) != 0) {
+		printf("parallel parse failed.\n");
+		return -1;
+	}
+
+	// 单线程解析同一份数据
+	libserial_parse_set_filter(&spbuf, &filter);
+	for (n = 0; n < size; n += used) {
+		if ((len = libserial_parse_feed_nl_span(&spbuf, data + n, size - n, &used, &span)) > 0) {
+			parallel_digest_line(&seq, span.ptr, span.len);
+		}
+	}
+	if ((len = libserial_parse_text_finish(&spbuf)) > 0) {
+		parallel_digest_line(&seq, spbuf.buf, len);
+	}
+
+	printf("parallel: %u lines %08x, sequential: %u lines %08x -> %s\n", par.count, par.hash, seq.count, seq.hash, 
+		(par.count == seq.count && par.hash == seq.hash) ? "same" : "different");
+	return (par.count == seq.count && par.hash == seq.hash) ? 0 : -1;
+}
+#endif
+
+#ifdef LIBSERIAL_PARSE_INTERN
+/*---------------------------------------------------------------------
+*	函数: 	intern_newline_example
+*	功能:	逐字节解析以行为分割符的文本, 重复出现的行通过驻留编号复用此前的处理结果
+*---------------------------------------------------------------------*/
+int intern_newline_example(const char* string)
+{
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
+	unsigned int mem[80] = { 0 };
+	libserial_parse_buf_t spbuf;
+	libserial_parse_intern_t cache;
+	unsigned int i = 0x00, len = 0x00;
+	int id = 0x00, seen = 0x00;
+
+	// 指定静态内存
+	spbuf.buf = buff;
+	spbuf.total = sizeof(buff);
+
+	// 初始化缓冲区并挂接行驻留缓存(8 个槽位, 每行最长 24 字节)
+	if ((len = libserial_parse_init(&spbuf)) == 0x00) {
+		printf("memory is too small.\n");
+		return -1;
+	}
+	if (libserial_parse_intern_init(&cache, 8, 24, mem, sizeof(mem)) == 0x00) {
+		printf("intern memory is too small, need %d bytes.\n", libserial_parse_intern_size(8, 24));
+		return -1;
+	}
+	libserial_parse_set_intern(&spbuf, &cache);
+
+	// 已驻留的行无需再次拆分和分发
+	for (i = 0; i < strlen(string); i++) {
+		if ((len = libserial_parse_text_nl(&spbuf, string[i])) > 0) {
+			id = libserial_parse_get_intern(&spbuf, &seen);
+			printf("[intern %d%s]: %-2d->[%s]\n", id, seen ? " seen" : "", len, spbuf.buf);
+		}
+	}
+
+	printf("[intern]: hits:%llu misses:%llu\n", cache.hits, cache.misses);
+	return 0;
+}
+#endif
+
 // 解析命令
 int serial_command_text(libserial_parse_buf_t* spbuf, const char* string)
 {
@@ -206,6 +469,253 @@ int serial_command_parse_example(const char* string)
 	return 0;
 }
 
+// 打印命令名称和参数
+int serial_command_print(void* ctx, char* line, const libserial_parse_token_t* argv, unsigned int argc)
+{
+	unsigned int i = 0x00;
+	(void)ctx;
+
+	printf("[command]: [%s]\n", line + argv[0].off);
+	for (i = 1; i < argc; i++) {
+		printf("[paramet]: [%s]\n", line + argv[i].off);
+	}
+	printf("\n");
+
+	// 执行命令代码......
+
+	return 0;
+}
+
+// 重启命令
+int serial_command_reboot(void* ctx, char* line, const libserial_parse_token_t* argv, unsigned int argc)
+{
+	(void)ctx;
+	(void)argc;
+	printf("[command]: [%s] rebooting...\n\n", line + argv[0].off);
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	serial_command_tokenize_example
+*	功能:	一次性拆分命令名称和参数并通过分发表执行命令的完整示例代码
+*---------------------------------------------------------------------*/
+int serial_command_tokenize_example(const char* string)
+{
+	static const libserial_parse_cmd_t cmds[] = {
+		{ "wifi",	serial_command_print },
+		{ "video",	serial_command_print },
+		{ "reg_w",	serial_command_print },
+		{ "reg_r",	serial_command_print },
+		{ "reboot",	serial_command_reboot },
+	};
+	static unsigned short slot[LIBSERIAL_PARSE_CMD_SLOTS(5)];
+	char buff[256 + LIBSERIAL_PARSE_INTERNAL_MAX] = { 0 };
+	libserial_parse_buf_t spbuf;
+	libserial_parse_token_t argv[16];
+	libserial_parse_cmd_table_t table;
+	unsigned int len = 0x00, used = 0x00, argc = 0x00, size = strlen(string);
+
+	// 指定静态内存
+	spbuf.buf = buff;
+	spbuf.total = sizeof(buff);
+
+	// 初始化缓冲区和命令分发表
+	if (libserial_parse_init(&spbuf) == 0x00) {
+		printf("memory is too small.\n");
+		return -1;
+	}
+	if (libserial_parse_cmd_init(&table, cmds, sizeof(cmds) / sizeof(cmds[0]), slot, sizeof(slot) / sizeof(slot[0])) == 0x00) {
+		printf("build command table failed.\n");
+		return -1;
+	}
+
+	// 按行解析不受分隔和忽略字符影响, 可以直接在同一个解析器上配置分词规则
+	libserial_parse_set_divide_set(&spbuf, " ,=");
+
+	// 模拟串口收到的数据
+	while (size > 0) {
+		len = libserial_parse_feed_nl(&spbuf, string, size, &used);
+		string += used;
+		size -= used;
+		if (len == 0) {
+			continue;
+		}
+
+		// 一次性拆分命令名称和参数
+		printf("[parse]:   [%s]\n", spbuf.buf);
+		if ((argc = libserial_parse_tokenize(&spbuf, spbuf.buf, len, argv, 16)) == 0) {
+			continue;
+		}
+
+		// 查找并执行命令
+		if (libserial_parse_cmd_exec(&table, NULL, spbuf.buf, argv, argc) == LIBSERIAL_PARSE_CMD_NONE) {
+			printf("[unknown]: [%s]\n\n", spbuf.buf + argv[0].off);
+		}
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	serial_command_fields_example
+*	功能:	拆分命令参数的同时转换数值和键值对的示例代码
+*---------------------------------------------------------------------*/
+int serial_command_fields_example(const char* string)
+{
+	char line[256] = { 0 };
+	libserial_parse_buf_t* spbuf = NULL;
+	libserial_parse_field_t fields[16];
+	unsigned int i = 0x00, count = 0x00, len = strlen(string);
+
+	// 只用于提供分词配置, 分隔字符中不能包含 '='
+	if ((spbuf = libserial_parse_create(64)) == NULL || libserial_parse_init(spbuf) == 0x00) {
+		printf("create parse buf failed.\n");
+		libserial_parse_release(spbuf);
+		return -1;
+	}
+	libserial_parse_set_divide_set(spbuf, " ,");
+
+	// 命令格式假定:  命令名称 地址1=数值1, 地址2=数值2
+	len = (len < sizeof(line)) ? len : sizeof(line) - 1;
+	memcpy(line, string, len);
+	count = libserial_parse_tokenize_fields(spbuf, line, len, fields, 16);
+	for (i = 0; i < count; i++) {
+		if (i == 0) {
+			printf("[command]: [%s]\n", line + fields[i].tok.off);
+		} else if (fields[i].vofs > 0 && fields[i].key.type != LIBSERIAL_PARSE_VALUE_TEXT && fields[i].value.type != LIBSERIAL_PARSE_VALUE_TEXT) {
+			printf("[field]:   [%s] key:0x%02llx value:0x%02llx\n", line + fields[i].tok.off, fields[i].key.i, fields[i].value.i);
+		} else if (fields[i].value.type == LIBSERIAL_PARSE_VALUE_TEXT) {
+			printf("[field]:   [%s] text, error at %u\n", line + fields[i].tok.off, fields[i].value.err);
+		} else {
+			printf("[field]:   [%s] value:%g\n", line + fields[i].tok.off, fields[i].value.f);
+		}
+	}
+
+	libserial_parse_release(spbuf);
+	return 0;
+}
+
+#if defined(__linux__)
+// 伪终端端口的回调上下文
+typedef struct{
+	int id;						// 端口编号, 用于区分各端口的回调
+	unsigned int lines;			// 收到的文本个数
+	char last[64];				// 最后收到的文本
+}serial_pty_port_t;
+
+// 伪终端端口的文本回调, delimiter 为 '\0' 时为空闲超时或文件结束时输出的不完整文本
+int serial_pty_on_token(void* ctx, const char* ptr, unsigned int len, char delimiter)
+{
+	serial_pty_port_t* port = (serial_pty_port_t*)ctx;
+	unsigned int n = (len < sizeof(port->last)) ? len : sizeof(port->last) - 1;
+
+	printf("[pty%d]: %-2u->[%.*s]%s\n", port->id, len, (int)len, ptr, delimiter ? "" : " (partial)");
+	memcpy(port->last, ptr, n);
+	port->last[n] = '\0';
+	port->lines++;
+	return 0;
+}
+
+// 读取各端口直到指定端口收到 lines 个文本, 最多等待约 1 秒
+int serial_pty_wait(libserial_parse_serial_t* serial, const serial_pty_port_t* port, unsigned int lines)
+{
+	unsigned int i = 0x00;
+
+	for (i = 0; i < 50 && port->lines < lines; i++) {
+		if (libserial_parse_serial_poll(serial, 20) < 0) {
+			return -1;
+		}
+	}
+	return (port->lines >= lines) ? 0 : -1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	serial_pty_example
+*	功能:	通过两个伪终端模拟串口, 在主设备端写入文本, 由串口读取器从从设备端读取并交给各端口的回调,
+*			同时演示空闲超时输出提示符(定义 LIBSERIAL_PARSE_IDLE 时)和对端关闭后输出剩余文本
+*---------------------------------------------------------------------*/
+int serial_pty_example(void)
+{
+	const char* lines0 = "reg_w 0x01=0x20\r\ntemp=21\r\n";
+	const char* lines1 = "video udp,192.168.1.115,8000\n";
+	libserial_parse_buf_t* spbuf[2] = { NULL, NULL };
+	libserial_parse_serial_t* serial = NULL;
+	libserial_parse_handler_t handler[2];
+	serial_pty_port_t port[2];
+	int master[2] = { -1, -1 }, slave[2] = { -1, -1 }, id[2] = { -1, -1 };
+	int i = 0x00, ret = -1;
+
+	memset(port, 0x00, sizeof(port));
+	if ((serial = libserial_parse_serial_create(0)) == NULL) {
+		printf("create serial reader failed.\n");
+		return -1;
+	}
+
+	// 每个伪终端对应一个端口, 各自拥有解析器和回调
+	for (i = 0; i < 2; i++) {
+		port[i].id = i;
+		handler[i].on_token = serial_pty_on_token;
+		handler[i].on_overflow = NULL;
+		handler[i].ctx = &port[i];
+		if (openpty(&master[i], &slave[i], NULL, NULL, NULL) < 0 || libserial_parse_serial_set_raw(slave[i], 0) < 0) {
+			printf("open pty failed.\n");
+			goto out;
+		}
+		if ((spbuf[i] = libserial_parse_create(256)) == NULL || libserial_parse_init(spbuf[i]) == 0x00) {
+			printf("create parse buf failed.\n");
+			goto out;
+		}
+		if ((id[i] = libserial_parse_serial_add(serial, slave[i], spbuf[i], LIBSERIAL_PARSE_SERIAL_NL, &handler[i])) < 0) {
+			printf("add pty failed.\n");
+			goto out;
+		}
+	}
+
+	// 在主设备端写入完整的行, 各端口的回调分别收到自己的文本
+	if (write(master[0], lines0, strlen(lines0)) < 0 || write(master[1], lines1, strlen(lines1)) < 0
+		|| serial_pty_wait(serial, &port[0], 2) < 0 || serial_pty_wait(serial, &port[1], 1) < 0) {
+		printf("read lines failed.\n");
+		goto out;
+	}
+
+#ifdef LIBSERIAL_PARSE_IDLE
+	// 没有换行的提示符在空闲 100 毫秒后输出
+	libserial_parse_set_idle(spbuf[1], 100);
+	if (write(master[1], "login:", 6) < 0 || serial_pty_wait(serial, &port[1], 2) < 0 || strcmp(port[1].last, "login:") != 0) {
+		printf("idle flush failed.\n");
+		goto out;
+	}
+#endif
+
+	// 读入没有换行的文本后关闭主设备, 从设备读取出错时端口被移出, 剩余文本通过回调输出
+	if (write(master[0], "bye", 3) < 0 || libserial_parse_serial_poll(serial, 100) < 0) {
+		printf("read partial failed.\n");
+		goto out;
+	}
+	close(master[0]);
+	master[0] = -1;
+	if (serial_pty_wait(serial, &port[0], 3) < 0 || strcmp(port[0].last, "bye") != 0 || libserial_parse_serial_fd(serial, id[0]) >= 0) {
+		printf("eof flush failed.\n");
+		goto out;
+	}
+	ret = 0;
+
+out:
+	printf("[pty]: port0 lines:%u port1 lines:%u -> %s\n", port[0].lines, port[1].lines, (0 == ret) ? "ok" : "failed");
+	libserial_parse_serial_release(serial);
+	for (i = 0; i < 2; i++) {
+		if (master[i] >= 0) {
+			close(master[i]);
+		}
+		if (slave[i] >= 0) {
+			close(slave[i]);
+		}
+		libserial_parse_release(spbuf[i]);
+	}
+	return ret;
+}
+#endif
+
 int main(void)
 {
 	const char* string = "@ABCDEFGHIJKLAA@\n\nQQ:1007566569\r\nlovemengx@qq.com\n123456789#++++++.....";
@@ -225,6 +735,47 @@ int main(void)
 	dynamic_mem_newline_example(string);
 	printf("------------------------------------\n");
 
+	// 静态内存解析以分隔字符集合分隔的字符串示例
+	printf("------------------------------------\n");
+	printf("static memory divide set example...\n");
+	printf("------------------------------------\n");
+	static_mem_divide_set_example(strcmd);
+	printf("------------------------------------\n");
+
+	// 数据块方式解析以行分隔的字符串示例
+	printf("------------------------------------\n");
+	printf("block feed newline example...\n");
+	printf("------------------------------------\n");
+	block_feed_newline_example(string);
+	printf("------------------------------------\n");
+
+#ifdef LIBSERIAL_PARSE_FILTER
+	// 数据块方式解析并过滤以行分隔的字符串示例
+	printf("------------------------------------\n");
+	printf("block filter newline example...\n");
+	printf("------------------------------------\n");
+	block_filter_newline_example(strcmds);
+	printf("------------------------------------\n");
+#endif
+
+#if defined(LIBSERIAL_PARSE_FILTER) && !defined(_WIN32)
+	// 多线程解析并过滤以行分隔的字符串示例
+	printf("------------------------------------\n");
+	printf("parallel filter newline example...\n");
+	printf("------------------------------------\n");
+	parallel_filter_newline_example();
+	printf("------------------------------------\n");
+#endif
+
+#ifdef LIBSERIAL_PARSE_INTERN
+	// 逐字节解析并驻留重复出现的行示例
+	printf("------------------------------------\n");
+	printf("intern newline example...\n");
+	printf("------------------------------------\n");
+	intern_newline_example("temp=21\nhum=40\ntemp=21\nreboot\nhum=40\n");
+	printf("------------------------------------\n");
+#endif
+
 	// 动态内存解析以自定义分隔和忽略的字符串示例
 	printf("------------------------------------\n");
 	printf("dynamic memory divide example...\n");
@@ -239,6 +790,29 @@ int main(void)
 	serial_command_parse_example(strcmds);
 	printf("------------------------------------\n");
 
+	// 一次性拆分命令名称和参数的完整示例
+	printf("------------------------------------\n");
+	printf("command tokenize example...\n");
+	printf("------------------------------------\n");
+	serial_command_tokenize_example(strcmds);
+	printf("------------------------------------\n");
+
+	// 拆分命令参数并转换数值的示例
+	printf("------------------------------------\n");
+	printf("command fields example...\n");
+	printf("------------------------------------\n");
+	serial_command_fields_example(strcmd);
+	printf("------------------------------------\n");
+
+#if defined(__linux__)
+	// 通过伪终端模拟串口的读取器示例
+	printf("------------------------------------\n");
+	printf("serial pty example...\n");
+	printf("------------------------------------\n");
+	serial_pty_example();
+	printf("------------------------------------\n");
+#endif
+
 	return 0;
 }
 
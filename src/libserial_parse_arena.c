@@ -0,0 +1,116 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_arena.c
+* @版本		V1.0.2
+* @日期
+* @概要		从用户提供的一整块内存中顺序分配解析器, 一次性整体回收, 适用于频繁创建和销毁解析器的场景
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#include <stddef.h>
+#include "libserial_parse_arena.h"
+
+// 分配空间的对齐字节数
+#ifndef LIBSERIAL_PARSE_ARENA_ALIGN
+#define LIBSERIAL_PARSE_ARENA_ALIGN		16
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_init
+*	功能:	使用用户提供的内存, 初始化内存区
+*	参数:	arena: 内存区
+*	返回:	可分配的字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_arena_init(libserial_parse_arena_t *arena)
+{
+	arena->used = 0x00;
+	return arena->total;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_alloc
+*	功能:	从内存区分配指定大小的空间
+*	参数:	arena: 内存区  size: 空间大小
+*	返回:	NULL: 剩余空间不足  	其他: 按 LIBSERIAL_PARSE_ARENA_ALIGN 字节对齐的空间
+*---------------------------------------------------------------------*/
+void *libserial_parse_arena_alloc(libserial_parse_arena_t *arena, unsigned int size)
+{
+	size_t addr = (size_t)(arena->buf + arena->used);
+	unsigned int pad = (unsigned int)(((addr + LIBSERIAL_PARSE_ARENA_ALIGN - 1) & ~(size_t)(LIBSERIAL_PARSE_ARENA_ALIGN - 1)) - addr);
+
+	if(arena->used > arena->total || pad > arena->total - arena->used || size > arena->total - arena->used - pad){
+		return NULL;
+	}
+
+	arena->used += pad + size;
+	return (void *)(addr + pad);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_reset
+*	功能:	一次性回收内存区分配出的全部空间, 时间复杂度 O(1)
+*	参数:	arena: 内存区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_arena_reset(libserial_parse_arena_t *arena)
+{
+	arena->used = 0x00;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_create
+*	功能:	从内存区一次分配解析器的描述信息、文本缓冲区和内部数据结构
+*	参数:	arena: 内存区  size: 可用缓冲区大小
+*	返回:	NULL: 剩余空间不足  	其他: 解析器缓冲区
+*	备注:	描述信息位于分配空间的起始位置, 文本缓冲区和内部数据结构紧随其后
+*---------------------------------------------------------------------*/
+libserial_parse_buf_t *libserial_parse_arena_create(libserial_parse_arena_t *arena, unsigned int size)
+{
+	libserial_parse_buf_t *spbuf = NULL;
+	unsigned int total = size + libserial_parse_internal_size();
+
+	if(0 == size || total < size || total > (unsigned int)-1 - sizeof(libserial_parse_buf_t)){
+		return NULL;
+	}
+	if((spbuf = (libserial_parse_buf_t *)libserial_parse_arena_alloc(arena, sizeof(libserial_parse_buf_t) + total)) == NULL){
+		return NULL;
+	}
+
+	spbuf->buf   = (char *)(spbuf + 1);
+	spbuf->total = total;
+#if defined(LIBSERIAL_PARSE_ALIGNED) || defined(LIBSERIAL_PARSE_GROW)
+	spbuf->obj = NULL;
+#endif
+
+	return spbuf;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_create_tokens
+*	功能:	从内存区一次分配文本收集区的描述信息、存储区和片段数组
+*	参数:	arena: 内存区  size: 存储区大小  argc: 片段数组可存储的片段个数
+*	返回:	NULL: 剩余空间不足  	其他: 已重置的文本收集区
+*---------------------------------------------------------------------*/
+libserial_parse_token_arena_t *libserial_parse_arena_create_tokens(libserial_parse_arena_t *arena, unsigned int size, unsigned int argc)
+{
+	libserial_parse_token_arena_t *tokens = NULL;
+	unsigned int head = sizeof(libserial_parse_token_arena_t) + argc * sizeof(libserial_parse_token_t);
+
+	if(0 == argc || argc > ((unsigned int)-1 - sizeof(libserial_parse_token_arena_t)) / sizeof(libserial_parse_token_t) || size > (unsigned int)-1 - head){
+		return NULL;
+	}
+	if((tokens = (libserial_parse_token_arena_t *)libserial_parse_arena_alloc(arena, head + size)) == NULL){
+		return NULL;
+	}
+
+	tokens->argv  = (libserial_parse_token_t *)(tokens + 1);
+	tokens->argc  = argc;
+	tokens->buf   = (char *)(tokens->argv + argc);
+	tokens->total = size;
+	libserial_parse_token_arena_reset(tokens);
+
+	return tokens;
+}
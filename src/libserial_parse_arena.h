@@ -0,0 +1,76 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_arena.h
+* @版本		V1.0.2
+* @日期
+* @概要		从用户提供的一整块内存中顺序分配解析器, 一次性整体回收, 适用于频繁创建和销毁解析器的场景
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#ifndef __LIB_SERIAL_PARSE_ARENA_H_
+#define __LIB_SERIAL_PARSE_ARENA_H_
+
+#include "libserial_parse_text.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 顺序分配的内存区, 内存由用户提供, 分配出的空间在 libserial_parse_arena_reset() 之前一直有效
+typedef struct{
+	char *buf;					// 内存区地址
+	unsigned int total;			// 内存区大小
+	unsigned int used;			// 已分配的字节数, 由接口内部维护
+}libserial_parse_arena_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_init
+*	功能:	使用用户提供的内存, 初始化内存区
+*	参数:	arena: 内存区
+*	返回:	可分配的字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_arena_init(libserial_parse_arena_t *arena);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_alloc
+*	功能:	从内存区分配指定大小的空间
+*	参数:	arena: 内存区  size: 空间大小
+*	返回:	NULL: 剩余空间不足  	其他: 按 LIBSERIAL_PARSE_ARENA_ALIGN 字节对齐的空间
+*---------------------------------------------------------------------*/
+void *libserial_parse_arena_alloc(libserial_parse_arena_t *arena, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_reset
+*	功能:	一次性回收内存区分配出的全部空间, 时间复杂度 O(1)
+*	参数:	arena: 内存区
+*	返回:	无返回值
+*	备注:	由该内存区创建的解析器、文本收集区随之失效, 无需逐个释放
+*---------------------------------------------------------------------*/
+void libserial_parse_arena_reset(libserial_parse_arena_t *arena);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_create
+*	功能:	从内存区一次分配解析器的描述信息、文本缓冲区和内部数据结构
+*	参数:	arena: 内存区  size: 可用缓冲区大小
+*	返回:	NULL: 剩余空间不足  	其他: 解析器缓冲区
+*	备注:	与 libserial_parse_create() 相同, 之后需调用 libserial_parse_init();
+*			不需要也不能调用 libserial_parse_release() 和 libserial_parse_set_grow()
+*---------------------------------------------------------------------*/
+libserial_parse_buf_t *libserial_parse_arena_create(libserial_parse_arena_t *arena, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_arena_create_tokens
+*	功能:	从内存区一次分配文本收集区的描述信息、存储区和片段数组
+*	参数:	arena: 内存区  size: 存储区大小  argc: 片段数组可存储的片段个数
+*	返回:	NULL: 剩余空间不足  	其他: 已重置的文本收集区, 可直接用于 libserial_parse_set_token_arena()
+*	备注:	挂接到解析器需定义 LIBSERIAL_PARSE_TOKENS
+*---------------------------------------------------------------------*/
+libserial_parse_token_arena_t *libserial_parse_arena_create_tokens(libserial_parse_arena_t *arena, unsigned int size, unsigned int argc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
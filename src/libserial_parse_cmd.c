@@ -0,0 +1,345 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_cmd.c
+* @版本		V1.0.2
+* @日期
+* @概要		基于完美哈希的命令分发表, 配合 libserial_parse_tokenize() 使用
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#include <string.h>
+#include "libserial_parse_cmd.h"
+
+// 每个桶平均容纳的命令个数
+#define LIBSERIAL_PARSE_CMD_BUCKET			4
+
+// 每个桶尝试种子的最大次数, 生成期间桶的种子位置以最高位标记尚未放置的桶并记录其命令个数
+#define LIBSERIAL_PARSE_CMD_SEED_MAX		0x8000
+#define LIBSERIAL_PARSE_CMD_PENDING			0x8000
+
+// 单个桶最多容纳的命令个数, 超出时退化为有序表
+#define LIBSERIAL_PARSE_CMD_GROUP			32
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_hash
+*	功能:	计算命令名称的 FNV-1a 哈希值
+*	参数:	name: 命令名称  len: 命令名称长度
+*	返回:	哈希值
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_cmd_hash(const char *name, unsigned int len)
+{
+	unsigned int hash = 2166136261U, i = 0x00;
+
+	for(i = 0; i < len; i++){
+		hash = (hash ^ (unsigned char)name[i]) * 16777619U;
+	}
+
+	return hash ^ (hash >> 15);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_mix
+*	功能:	以桶的种子打散哈希值, 用于确定命令所在的哈希槽
+*	参数:	hash: 命令名称的哈希值  seed: 桶的种子
+*	返回:	打散后的哈希值
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_cmd_mix(unsigned int hash, unsigned int seed)
+{
+	hash ^= seed * 0x9E3779B9U;
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6BU;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35U;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_reduce
+*	功能:	将哈希值映射到 [0, n) 区间, n 不必是 2 的幂
+*	参数:	hash: 哈希值  n: 区间大小
+*	返回:	区间内的下标
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_cmd_reduce(unsigned int hash, unsigned int n)
+{
+	return (unsigned int)(((unsigned long long)hash * n) >> 32);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_compare
+*	功能:	比较命令名称, 顺序与 strcmp() 一致
+*	参数:	name: 命令名称(无需 '\0' 结尾)  len: 命令名称长度  key: 命令表中的名称
+*	返回:	<0: name 较小  0: 相同  >0: name 较大
+*---------------------------------------------------------------------*/
+static int libserial_parse_cmd_compare(const char *name, unsigned int len, const char *key)
+{
+	unsigned int i = 0x00;
+
+	for(i = 0; i < len && '\0' != key[i] && name[i] == key[i]; i++);
+	if(i < len){
+		return ('\0' == key[i]) ? 1 : (int)(unsigned char)name[i] - (int)(unsigned char)key[i];
+	}
+
+	return ('\0' == key[i]) ? 0 : -1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_unique
+*	功能:	检查命令的哈希值是否互不相同
+*	参数:	cmds: 命令表  count: 命令个数
+*	返回:	-1: 命令重名  0: 哈希值互不相同  1: 不同的命令哈希值相同(无法生成完美哈希)
+*---------------------------------------------------------------------*/
+static int libserial_parse_cmd_unique(const libserial_parse_cmd_t *cmds, unsigned int count)
+{
+	unsigned int i = 0x00, j = 0x00, hash = 0x00;
+
+	for(i = 1; i < count; i++){
+		hash = libserial_parse_cmd_hash(cmds[i].name, strlen(cmds[i].name));
+		for(j = 0; j < i; j++){
+			if(libserial_parse_cmd_hash(cmds[j].name, strlen(cmds[j].name)) == hash){
+				return (strcmp(cmds[j].name, cmds[i].name) == 0) ? -1 : 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_place
+*	功能:	为一个桶寻找种子, 使桶内的命令都落入空闲的哈希槽
+*	参数:	cmds: 命令表  count: 命令个数  slot: 哈希槽  nbucket: 桶个数  nslot: 桶之后的哈希槽个数  bucket: 桶
+*	返回:	-1: 找不到可用的种子  0: 放置成功, 种子已写入 slot[bucket]
+*---------------------------------------------------------------------*/
+static int libserial_parse_cmd_place(const libserial_parse_cmd_t *cmds, unsigned int count, unsigned short *slot, unsigned int nbucket, unsigned int nslot, unsigned int bucket)
+{
+	unsigned short *table = slot + nbucket, id[LIBSERIAL_PARSE_CMD_GROUP];
+	unsigned int hash[LIBSERIAL_PARSE_CMD_GROUP], pos[LIBSERIAL_PARSE_CMD_GROUP];
+	unsigned int size = slot[bucket] & ~LIBSERIAL_PARSE_CMD_PENDING, seed = 0x00, i = 0x00, n = 0x00, k = 0x00;
+
+	// 先取出桶内的命令, 尝试种子时不再遍历命令表
+	for(i = 0; i < count && n < size; i++){
+		hash[n] = libserial_parse_cmd_hash(cmds[i].name, strlen(cmds[i].name));
+		if(libserial_parse_cmd_reduce(hash[n], nbucket) == bucket){
+			id[n++] = (unsigned short)(i + 1);
+		}
+	}
+
+	for(seed = 0; seed < LIBSERIAL_PARSE_CMD_SEED_MAX; seed++){
+		for(k = 0; k < n; k++){
+			pos[k] = libserial_parse_cmd_reduce(libserial_parse_cmd_mix(hash[k], seed), nslot);
+			if(table[pos[k]]){
+				break;
+			}
+			table[pos[k]] = id[k];
+		}
+		if(k >= n){
+			slot[bucket] = (unsigned short)seed;
+			return 0;
+		}
+
+		// 撤销本次尝试中已放置的命令
+		while(k-- > 0){
+			table[pos[k]] = 0x00;
+		}
+	}
+
+	return -1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_displace
+*	功能:	生成两级完美哈希: 命令先按哈希值分桶, 再按桶从大到小为每个桶寻找种子
+*	参数:	cmds: 命令表  count: 命令个数  slot: 哈希槽  nbucket: 桶个数  nslot: 桶之后的哈希槽个数
+*	返回:	-1: 生成失败  0: 生成成功
+*---------------------------------------------------------------------*/
+static int libserial_parse_cmd_displace(const libserial_parse_cmd_t *cmds, unsigned int count, unsigned short *slot, unsigned int nbucket, unsigned int nslot)
+{
+	unsigned int i = 0x00, b = 0x00, size = 0x00, most = 0x00;
+
+	// 统计各桶的命令个数
+	memset(slot, 0x00, (nbucket + nslot) * sizeof(unsigned short));
+	for(i = 0; i < count; i++){
+		b = libserial_parse_cmd_reduce(libserial_parse_cmd_hash(cmds[i].name, strlen(cmds[i].name)), nbucket);
+		if(++slot[b] > most){
+			most = slot[b];
+		}
+	}
+	if(most > LIBSERIAL_PARSE_CMD_GROUP){
+		return -1;
+	}
+	for(b = 0; b < nbucket; b++){
+		slot[b] |= LIBSERIAL_PARSE_CMD_PENDING;
+	}
+
+	// 命令较多的桶可选的位置多, 优先放置
+	for(size = most; size > 0; size--){
+		for(b = 0; b < nbucket; b++){
+			if((LIBSERIAL_PARSE_CMD_PENDING | size) == slot[b] && libserial_parse_cmd_place(cmds, count, slot, nbucket, nslot, b) < 0){
+				return -1;
+			}
+		}
+	}
+	for(b = 0; b < nbucket; b++){
+		if(LIBSERIAL_PARSE_CMD_PENDING == slot[b]){
+			slot[b] = 0x00;
+		}
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_sift
+*	功能:	堆排序的下沉操作, 按命令名称排序命令表下标
+*	参数:	cmds: 命令表  order: 命令表下标  root: 起始位置  count: 堆大小
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_cmd_sift(const libserial_parse_cmd_t *cmds, unsigned short *order, unsigned int root, unsigned int count)
+{
+	unsigned int child = 0x00;
+	unsigned short tmp = 0x00;
+
+	while((child = root * 2 + 1) < count){
+		if(child + 1 < count && strcmp(cmds[order[child]].name, cmds[order[child + 1]].name) < 0){
+			child++;
+		}
+		if(strcmp(cmds[order[root]].name, cmds[order[child]].name) >= 0){
+			break;
+		}
+		tmp = order[root];
+		order[root]  = order[child];
+		order[child] = tmp;
+		root = child;
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_sort
+*	功能:	生成按命令名称排序的有序表, 用于二分查找
+*	参数:	cmds: 命令表  count: 命令个数  order: 返回排序后的命令表下标
+*	返回:	-1: 命令重名  0: 生成成功
+*---------------------------------------------------------------------*/
+static int libserial_parse_cmd_sort(const libserial_parse_cmd_t *cmds, unsigned int count, unsigned short *order)
+{
+	unsigned int i = 0x00;
+	unsigned short tmp = 0x00;
+
+	for(i = 0; i < count; i++){
+		order[i] = (unsigned short)i;
+	}
+	for(i = count / 2; i > 0; i--){
+		libserial_parse_cmd_sift(cmds, order, i - 1, count);
+	}
+	for(i = count - 1; i > 0; i--){
+		tmp = order[0];
+		order[0] = order[i];
+		order[i] = tmp;
+		libserial_parse_cmd_sift(cmds, order, 0, i);
+	}
+
+	for(i = 1; i < count; i++){
+		if(strcmp(cmds[order[i - 1]].name, cmds[order[i]].name) == 0){
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_init
+*	功能:	使用用户提供的哈希槽, 为静态命令表生成无冲突的完美哈希分发表
+*	参数:	tab: 分发表  cmds: 命令表  count: 命令个数  slot: 哈希槽  nslot: 哈希槽个数
+*	返回:	0: 生成失败(哈希槽少于命令个数或命令重名)  	>0: 实际使用的哈希槽个数
+*	备注:	nslot 不小于 LIBSERIAL_PARSE_CMD_SLOTS(count) 时生成两级完美哈希, 多出的哈希槽可加快生成;
+*			哈希槽不足或找不到可用的种子时退化为按名称排序的有序表(二分查找), 此时只要求 nslot 不小于 count
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_cmd_init(libserial_parse_cmd_table_t *tab, const libserial_parse_cmd_t *cmds, unsigned int count, unsigned short *slot, unsigned int nslot)
+{
+	unsigned int nbucket = (count + LIBSERIAL_PARSE_CMD_BUCKET - 1) / LIBSERIAL_PARSE_CMD_BUCKET;
+	int ret = 0x00;
+
+	if(0 == count || count >= 0xFFFF || nslot < count){
+		return 0;
+	}
+
+	// 哈希槽足够时生成两级完美哈希
+	tab->cmds = cmds;
+	tab->slot = slot;
+	if(count < LIBSERIAL_PARSE_CMD_PENDING && nslot >= nbucket + count){
+		if((ret = libserial_parse_cmd_unique(cmds, count)) < 0){
+			return 0;
+		}
+		if(0 == ret && libserial_parse_cmd_displace(cmds, count, slot, nbucket, nslot - nbucket) == 0){
+			tab->nbucket = nbucket;
+			tab->nslot   = nslot - nbucket;
+			return nslot;
+		}
+	}
+
+	// 退化为有序表
+	if(libserial_parse_cmd_sort(cmds, count, slot) < 0){
+		return 0;
+	}
+	tab->nbucket = 0x00;
+	tab->nslot   = count;
+	return count;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_find
+*	功能:	以 O(1) 时间查找命令(退化为有序表时为 O(log n))
+*	参数:	tab: 分发表  name: 命令名称(无需 '\0' 结尾)  len: 命令名称长度
+*	返回:	NULL: 没有找到  	其他: 命令描述
+*---------------------------------------------------------------------*/
+const libserial_parse_cmd_t *libserial_parse_cmd_find(const libserial_parse_cmd_table_t *tab, const char *name, unsigned int len)
+{
+	unsigned int hash = 0x00, idx = 0x00, lo = 0x00, hi = tab->nslot, mid = 0x00;
+	int cmp = 0x00;
+
+	if(tab->nbucket){
+		// 空槽或者名称不一致都说明不是已注册的命令
+		hash = libserial_parse_cmd_hash(name, len);
+		idx  = libserial_parse_cmd_reduce(libserial_parse_cmd_mix(hash, tab->slot[libserial_parse_cmd_reduce(hash, tab->nbucket)]), tab->nslot);
+		idx  = tab->slot[tab->nbucket + idx];
+		if(0 == idx || libserial_parse_cmd_compare(name, len, tab->cmds[idx - 1].name) != 0){
+			return NULL;
+		}
+		return &tab->cmds[idx - 1];
+	}
+
+	while(lo < hi){
+		mid = lo + (hi - lo) / 2;
+		if((cmp = libserial_parse_cmd_compare(name, len, tab->cmds[tab->slot[mid]].name)) == 0){
+			return &tab->cmds[tab->slot[mid]];
+		}
+		if(cmp < 0){
+			hi = mid;
+		}else{
+			lo = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_exec
+*	功能:	以 argv[0] 为命令名称查找并调用命令处理函数
+*	参数:	tab: 分发表  ctx: 用户上下文  line: 分词后的行文本  argv: 片段信息  argc: 片段个数
+*	返回:	LIBSERIAL_PARSE_CMD_NONE: 没有匹配的命令  	其他: 命令处理函数的返回值
+*	备注:	可直接使用 libserial_parse_tokenize() 的输出
+*---------------------------------------------------------------------*/
+int libserial_parse_cmd_exec(const libserial_parse_cmd_table_t *tab, void *ctx, char *line, const libserial_parse_token_t *argv, unsigned int argc)
+{
+	const libserial_parse_cmd_t *cmd = NULL;
+
+	if(0 == argc || (cmd = libserial_parse_cmd_find(tab, line + argv[0].off, argv[0].len)) == NULL){
+		return LIBSERIAL_PARSE_CMD_NONE;
+	}
+
+	return cmd->func(ctx, line, argv, argc);
+}
@@ -0,0 +1,77 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_cmd.h
+* @版本		V1.0.2
+* @日期
+* @概要		基于完美哈希的命令分发表, 配合 libserial_parse_tokenize() 使用
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#ifndef __LIB_SERIAL_PARSE_CMD_H_
+#define __LIB_SERIAL_PARSE_CMD_H_
+
+#include "libserial_parse_text.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIBSERIAL_PARSE_CMD_NONE			(-1)		// 没有找到匹配的命令
+
+// 命令处理函数, line 为分词后的行文本, argv[0] 为命令名称
+typedef int (*libserial_parse_cmd_func_t)(void *ctx, char *line, const libserial_parse_token_t *argv, unsigned int argc);
+
+// 命令描述
+typedef struct{
+	const char *name;						// 命令名称
+	libserial_parse_cmd_func_t func;		// 命令处理函数
+}libserial_parse_cmd_t;
+
+// 生成两级完美哈希所需的哈希槽个数: 每 4 个命令一个桶种子, 加上与命令个数相同的哈希槽
+#define LIBSERIAL_PARSE_CMD_SLOTS(count)	((count) + ((count) + 3) / 4)
+
+// 命令分发表, 由 libserial_parse_cmd_init() 生成
+typedef struct{
+	const libserial_parse_cmd_t *cmds;		// 命令表
+	unsigned short *slot;					// 前 nbucket 个为各桶的种子, 其后为哈希槽(存储命令表下标 + 1, 0 代表空槽);
+											// 有序表时为按名称排序的命令表下标
+	unsigned int nbucket;					// 桶个数, 0 代表退化为有序表
+	unsigned int nslot;						// 桶之后的哈希槽个数(有序表时为命令个数)
+}libserial_parse_cmd_table_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_init
+*	功能:	使用用户提供的哈希槽, 为静态命令表生成无冲突的完美哈希分发表
+*	参数:	tab: 分发表  cmds: 命令表  count: 命令个数  slot: 哈希槽  nslot: 哈希槽个数
+*	返回:	0: 生成失败(哈希槽少于命令个数或命令重名)  	>0: 实际使用的哈希槽个数
+*	备注:	命令先按哈希值分桶, 再为每个桶寻找使其命令落入空槽的种子(hash-and-displace),
+*			nslot 不小于 LIBSERIAL_PARSE_CMD_SLOTS(count) (约为命令个数的 1.25 倍)即可, 多出的哈希槽可加快生成;
+*			哈希槽不足或找不到可用的种子时退化为按名称排序的有序表(二分查找), 此时只要求 nslot 不小于 count;
+*			只在初始化时执行一次, 不申请内存, 命令表和哈希槽在使用期间需保持有效
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_cmd_init(libserial_parse_cmd_table_t *tab, const libserial_parse_cmd_t *cmds, unsigned int count, unsigned short *slot, unsigned int nslot);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_find
+*	功能:	以 O(1) 时间查找命令(退化为有序表时为 O(log n))
+*	参数:	tab: 分发表  name: 命令名称(无需 '\0' 结尾)  len: 命令名称长度
+*	返回:	NULL: 没有找到  	其他: 命令描述
+*---------------------------------------------------------------------*/
+const libserial_parse_cmd_t *libserial_parse_cmd_find(const libserial_parse_cmd_table_t *tab, const char *name, unsigned int len);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_cmd_exec
+*	功能:	以 argv[0] 为命令名称查找并调用命令处理函数
+*	参数:	tab: 分发表  ctx: 用户上下文  line: 分词后的行文本  argv: 片段信息  argc: 片段个数
+*	返回:	LIBSERIAL_PARSE_CMD_NONE: 没有匹配的命令  	其他: 命令处理函数的返回值
+*	备注:	可直接使用 libserial_parse_tokenize() 的输出
+*---------------------------------------------------------------------*/
+int libserial_parse_cmd_exec(const libserial_parse_cmd_table_t *tab, void *ctx, char *line, const libserial_parse_token_t *argv, unsigned int argc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
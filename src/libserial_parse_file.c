@@ -0,0 +1,491 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_file.c
+* @版本		V1.0.2
+* @日期
+* @概要		批量解析日志/抓包文件中以换行符为终止符的文本(POSIX 平台)
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "libserial_parse_file.h"
+
+// 每个数据块的最小长度, 实际在其后的第一个换行符处切分
+#ifndef LIBSERIAL_PARSE_FILE_CHUNK
+#define LIBSERIAL_PARSE_FILE_CHUNK		(1024 * 1024)
+#endif
+
+// 每个线程最多领先输出位置的数据块个数, 限制缓存的解析结果
+#ifndef LIBSERIAL_PARSE_FILE_WINDOW
+#define LIBSERIAL_PARSE_FILE_WINDOW		4
+#endif
+
+// 单次交给解析器的最大长度
+#define LIBSERIAL_PARSE_FILE_SLICE		0x40000000U
+
+// 解析得到的文本
+typedef struct {
+	const char *ptr;		// 指向输入数据, NULL 代表文本位于数据块的文本存储区
+	unsigned int len;		// 文本长度
+}parse_line_t;
+
+// 数据块及其解析结果
+typedef struct {
+	const char *data;		// 数据块地址
+	size_t size;			// 数据块长度
+	parse_line_t *line;		// 文本列表
+	size_t nline, mline;	// 文本个数, 列表容量
+	char *text;				// 文本存储区, 保存被改写过的文本
+	size_t ntext, mtext;	// 已使用长度, 存储区容量
+	int done;				// 已解析完成
+}parse_chunk_t;
+
+// 并行解析任务
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	libserial_parse_buf_t *spbuf;	// 提供配置和未完成文本的解析器
+	unsigned int size;				// 各线程私有解析器的大小
+#ifdef LIBSERIAL_PARSE_GROW
+	unsigned int limit;				// 各线程私有解析器的增长上限
+#endif
+#ifdef LIBSERIAL_PARSE_FILTER
+	const libserial_parse_filter_t *filter;	// 各线程私有解析器挂接的行过滤器(只读, 可共享)
+#endif
+	parse_chunk_t *chunk;			// 数据块列表
+	size_t count;					// 数据块个数
+	size_t next;					// 下一个待解析的数据块
+	size_t emit;					// 下一个待输出的数据块
+	size_t window;					// 允许领先输出位置的数据块个数
+	int stop;						// 停止解析
+	int error;						// 申请资源失败
+}parse_parallel_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_chunk_add
+*	功能:	记录一条解析得到的文本, 位于解析器缓冲区的文本被复制到存储区
+*	参数:	chunk: 数据块  spbuf: 解析器缓冲区  span: 文本位置
+*	返回:	-1: 申请内存失败  0: 成功
+*---------------------------------------------------------------------*/
+static int libserial_parse_chunk_add(parse_chunk_t *chunk, libserial_parse_buf_t *spbuf, const libserial_parse_span_t *span)
+{
+	parse_line_t *line = NULL;
+	char *text = NULL;
+	size_t size = 0x00;
+
+	if(chunk->nline == chunk->mline){
+		size = chunk->mline ? chunk->mline * 2 : 256;
+		if((line = (parse_line_t *)realloc(chunk->line, size * sizeof(parse_line_t))) == NULL){
+			return -1;
+		}
+		chunk->line  = line;
+		chunk->mline = size;
+	}
+
+	line = &chunk->line[chunk->nline++];
+	line->ptr = span->ptr;
+	line->len = span->len;
+	if(span->ptr != spbuf->buf){
+		return 0;
+	}
+
+	// 被改写的文本连同 '\0' 一起保存
+	if(chunk->ntext + span->len + 1 > chunk->mtext){
+		size = chunk->mtext ? chunk->mtext : 4096;
+		while(size < chunk->ntext + span->len + 1){
+			size *= 2;
+		}
+		if((text = (char *)realloc(chunk->text, size)) == NULL){
+			return -1;
+		}
+		chunk->text  = text;
+		chunk->mtext = size;
+	}
+	memcpy(chunk->text + chunk->ntext, span->ptr, span->len);
+	chunk->text[chunk->ntext + span->len] = '\0';
+	chunk->ntext += span->len + 1;
+	line->ptr = NULL;
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_chunk_parse
+*	功能:	解析一个数据块
+*	参数:	chunk: 数据块  spbuf: 解析器缓冲区  last: 是否为最后一个数据块
+*	返回:	-1: 申请内存失败  0: 成功
+*	备注:	除最后一个数据块外均以换行符结束, 解析器状态在块之间无需传递
+*---------------------------------------------------------------------*/
+static int libserial_parse_chunk_parse(parse_chunk_t *chunk, libserial_parse_buf_t *spbuf, int last)
+{
+	const char *data = chunk->data;
+	size_t size = chunk->size;
+	unsigned int len = 0x00, used = 0x00, part = 0x00;
+	libserial_parse_span_t span;
+
+	while(size > 0){
+		part = (size < LIBSERIAL_PARSE_FILE_SLICE) ? (unsigned int)size : LIBSERIAL_PARSE_FILE_SLICE;
+		len  = libserial_parse_feed_nl_span(spbuf, data, part, &used, &span);
+		data += used;
+		size -= used;
+		if(len > 0 && libserial_parse_chunk_add(chunk, spbuf, &span) < 0){
+			return -1;
+		}
+	}
+
+	// 数据末尾未以换行符结束的文本同样输出
+	if(last && (len = libserial_parse_text_finish(spbuf)) > 0){
+		span.ptr = spbuf->buf;
+		span.len = len;
+		return libserial_parse_chunk_add(chunk, spbuf, &span);
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_chunk_emit
+*	功能:	按顺序输出数据块的文本并释放解析结果
+*	参数:	chunk: 数据块  func: 文本回调  ctx: 回调参数
+*	返回:	0: 全部输出  其他: 回调返回的非 0 值
+*---------------------------------------------------------------------*/
+static int libserial_parse_chunk_emit(parse_chunk_t *chunk, libserial_parse_line_func_t func, void *ctx)
+{
+	const char *text = chunk->text;
+	size_t i = 0x00;
+	int ret = 0x00;
+
+	for(i = 0; i < chunk->nline && 0 == ret; i++){
+		if(chunk->line[i].ptr){
+			ret = func(ctx, chunk->line[i].ptr, chunk->line[i].len);
+			continue;
+		}
+		ret = func(ctx, text, chunk->line[i].len);
+		text += chunk->line[i].len + 1;
+	}
+
+	free(chunk->line);
+	free(chunk->text);
+	chunk->line = NULL;
+	chunk->text = NULL;
+	return ret;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_parallel_worker
+*	功能:	解析线程, 按顺序领取数据块并解析, 领先输出位置过多时等待
+*	参数:	arg: 并行解析任务
+*	返回:	NULL
+*	备注:	第一个数据块使用调用者的解析器, 以便与其中尚未完成的文本合并;
+*			该解析器可能正被其他线程使用(可增长时会被重新分配), 其大小只使用启动前记录的值
+*---------------------------------------------------------------------*/
+static void *libserial_parse_parallel_worker(void *arg)
+{
+	parse_parallel_t *par = (parse_parallel_t *)arg;
+	libserial_parse_buf_t *spbuf = NULL;
+	size_t k = 0x00;
+	int ret = 0x00;
+
+	spbuf = libserial_parse_create(par->size);
+	if(spbuf){
+		libserial_parse_init(spbuf);
+		libserial_parse_set_config(spbuf, par->spbuf);
+#ifdef LIBSERIAL_PARSE_FILTER
+		libserial_parse_set_filter(spbuf, par->filter);
+#endif
+#ifdef LIBSERIAL_PARSE_GROW
+		if(par->limit > 0 && 0 == libserial_parse_set_grow(spbuf, par->limit)){
+			libserial_parse_release(spbuf);
+			spbuf = NULL;
+		}
+#endif
+	}
+
+	pthread_mutex_lock(&par->lock);
+	if(NULL == spbuf){
+		par->error = 1;
+		par->stop  = 1;
+		pthread_cond_broadcast(&par->cond);
+		pthread_mutex_unlock(&par->lock);
+		return NULL;
+	}
+
+	for(;;){
+		while(!par->stop && par->next < par->count && par->next >= par->emit + par->window){
+			pthread_cond_wait(&par->cond, &par->lock);
+		}
+		if(par->stop || par->next >= par->count){
+			break;
+		}
+		k = par->next++;
+		pthread_mutex_unlock(&par->lock);
+
+		ret = libserial_parse_chunk_parse(&par->chunk[k], (0 == k) ? par->spbuf : spbuf, k == par->count - 1);
+
+		pthread_mutex_lock(&par->lock);
+		par->chunk[k].done = 1;
+		if(ret < 0){
+			par->error = 1;
+			par->stop  = 1;
+		}
+		pthread_cond_broadcast(&par->cond);
+	}
+	pthread_mutex_unlock(&par->lock);
+
+	libserial_parse_release(spbuf);
+	return NULL;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_parallel_split
+*	功能:	在换行符之后将数据切分为多个数据块
+*	参数:	par: 并行解析任务  data: 输入数据  size: 数据长度
+*	返回:	-1: 申请内存失败  0: 成功
+*	备注:	至少产生一个数据块, 以便输出解析器中尚未完成的文本
+*---------------------------------------------------------------------*/
+static int libserial_parse_parallel_split(parse_parallel_t *par, const char *data, size_t size)
+{
+	size_t pos = 0x00, end = 0x00;
+	const char *nl = NULL;
+
+	par->chunk = (parse_chunk_t *)calloc(size / LIBSERIAL_PARSE_FILE_CHUNK + 1, sizeof(parse_chunk_t));
+	if(NULL == par->chunk){
+		return -1;
+	}
+
+	do{
+		end = size;
+		if(size - pos > LIBSERIAL_PARSE_FILE_CHUNK){
+			nl  = (const char *)memchr(data + pos + LIBSERIAL_PARSE_FILE_CHUNK - 1, '\n', size - pos - LIBSERIAL_PARSE_FILE_CHUNK + 1);
+			end = nl ? (size_t)(nl - data) + 1 : size;
+		}
+		par->chunk[par->count].data = data + pos;
+		par->chunk[par->count].size = end - pos;
+		par->count++;
+		pos = end;
+	}while(pos < size);
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_parallel
+*	功能:	使用多个线程解析内存块中以换行符为终止符的文本, 按原始顺序输出
+*	参数:	spbuf: 已配置好的解析器缓冲区  data: 输入数据  size: 数据长度
+*			threads: 线程个数(0: 使用在线的处理器个数)  func: 文本回调  ctx: 回调参数
+*	返回:	-1: 申请资源失败或已挂接行驻留缓存  0: 解析完成  其他: 回调返回的非 0 值
+*---------------------------------------------------------------------*/
+int libserial_parse_parallel(libserial_parse_buf_t *spbuf, const char *data, size_t size, unsigned int threads, libserial_parse_line_func_t func, void *ctx)
+{
+	parse_parallel_t par;
+	pthread_t *tid = NULL;
+	unsigned int i = 0x00, n = 0x00;
+	size_t k = 0x00;
+	int ret = 0x00;
+
+#ifdef LIBSERIAL_PARSE_INTERN
+	// 驻留编号与文本出现的顺序相关, 多个线程无法共享同一个驻留缓存
+	if(libserial_parse_get_intern_cache(spbuf)){
+		return -1;
+	}
+#endif
+
+	memset(&par, 0x00, sizeof(par));
+	if(libserial_parse_parallel_split(&par, data, size) < 0){
+		return -1;
+	}
+
+	if(0 == threads){
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = (cpus > 0) ? (unsigned int)cpus : 1;
+	}
+	threads = (threads < par.count) ? threads : (unsigned int)par.count;
+	if((tid = (pthread_t *)malloc(threads * sizeof(pthread_t))) == NULL){
+		free(par.chunk);
+		return -1;
+	}
+
+	par.spbuf  = spbuf;
+	par.window = (size_t)threads * LIBSERIAL_PARSE_FILE_WINDOW;
+	par.size   = spbuf->total - libserial_parse_internal_size();
+#ifdef LIBSERIAL_PARSE_GROW
+	par.limit  = libserial_parse_get_grow(spbuf);
+
+	// 调用者的缓冲区可增长时内部数据结构不在其中, 私有解析器同样启用增长
+	if(par.limit > 0){
+		par.size = spbuf->total;
+	}
+#endif
+#ifdef LIBSERIAL_PARSE_FILTER
+	par.filter = libserial_parse_get_filter(spbuf);
+#endif
+	pthread_mutex_init(&par.lock, NULL);
+	pthread_cond_init(&par.cond, NULL);
+	for(i = 0; i < threads; i++){
+		if(pthread_create(&tid[n], NULL, libserial_parse_parallel_worker, &par) == 0){
+			n++;
+		}
+	}
+
+	// 调用者线程按顺序输出已解析完成的数据块
+	pthread_mutex_lock(&par.lock);
+	par.error = (0 == n);
+	par.stop  = par.error;
+	while(!par.stop && par.emit < par.count){
+		if(!par.chunk[par.emit].done){
+			pthread_cond_wait(&par.cond, &par.lock);
+			continue;
+		}
+		pthread_mutex_unlock(&par.lock);
+		ret = libserial_parse_chunk_emit(&par.chunk[par.emit], func, ctx);
+		pthread_mutex_lock(&par.lock);
+		par.stop = (0 != ret);
+		par.emit++;
+		pthread_cond_broadcast(&par.cond);
+	}
+	par.stop = 1;
+	pthread_cond_broadcast(&par.cond);
+	pthread_mutex_unlock(&par.lock);
+
+	for(i = 0; i < n; i++){
+		pthread_join(tid[i], NULL);
+	}
+	for(k = par.emit; k < par.count; k++){
+		free(par.chunk[k].line);
+		free(par.chunk[k].text);
+	}
+
+	// 提前结束时丢弃解析器中的残留文本
+	if(par.error || ret){
+		libserial_parse_reset_buf(spbuf);
+	}
+
+	pthread_cond_destroy(&par.cond);
+	pthread_mutex_destroy(&par.lock);
+	free(par.chunk);
+	free(tid);
+
+	return par.error ? -1 : ret;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_file_map
+*	功能:	以只读方式映射整个文件
+*	参数:	path: 文件路径  size: 返回文件长度  advice: 传递给 madvise() 的访问方式
+*	返回:	NULL: 打开或映射文件失败  其他: 映射地址, 空文件返回 ""(无需解除映射)
+*---------------------------------------------------------------------*/
+static const char *libserial_parse_file_map(const char *path, size_t *size, int advice)
+{
+	struct stat st;
+	void *addr = NULL;
+	int fd = -1;
+
+	if((fd = open(path, O_RDONLY)) < 0){
+		return NULL;
+	}
+	if(fstat(fd, &st) < 0){
+		close(fd);
+		return NULL;
+	}
+
+	// 空文件无法映射, 只需输出解析器中尚未完成的文本
+	*size = (size_t)st.st_size;
+	if(0 == *size){
+		close(fd);
+		return "";
+	}
+
+	addr = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(MAP_FAILED == addr){
+		return NULL;
+	}
+
+	madvise(addr, *size, advice);
+	return (const char *)addr;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_file_unmap
+*	功能:	解除文件映射
+*	参数:	addr: 映射地址  size: 文件长度
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_file_unmap(const char *addr, size_t size)
+{
+	if(size > 0){
+		munmap((void *)addr, size);
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_file_parallel
+*	功能:	映射文件并使用多个线程解析以换行符为终止符的文本, 按原始顺序输出
+*	参数:	spbuf: 已配置好的解析器缓冲区  path: 文件路径
+*			threads: 线程个数(0: 使用在线的处理器个数)  func: 文本回调  ctx: 回调参数
+*	返回:	-1: 打开文件、申请资源失败或已挂接行驻留缓存  0: 解析完成  其他: 回调返回的非 0 值
+*---------------------------------------------------------------------*/
+int libserial_parse_file_parallel(libserial_parse_buf_t *spbuf, const char *path, unsigned int threads, libserial_parse_line_func_t func, void *ctx)
+{
+	const char *addr = NULL;
+	size_t size = 0x00;
+	int ret = 0x00;
+
+	// 各线程同时访问文件的不同位置, 提示内核尽早读入
+	if((addr = libserial_parse_file_map(path, &size, MADV_WILLNEED)) == NULL){
+		return -1;
+	}
+
+	ret = libserial_parse_parallel(spbuf, addr, size, threads, func, ctx);
+	libserial_parse_file_unmap(addr, size);
+	return ret;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_file_mmap
+*	功能:	映射文件并顺序解析以换行符为终止符的文本, 通过回调逐条输出
+*	参数:	spbuf: 已配置好的解析器缓冲区  path: 文件路径  func: 文本回调  ctx: 回调参数
+*	返回:	-1: 打开文件失败  0: 解析完成  其他: 回调返回的非 0 值
+*---------------------------------------------------------------------*/
+int libserial_parse_file_mmap(libserial_parse_buf_t *spbuf, const char *path, libserial_parse_line_func_t func, void *ctx)
+{
+	const char *addr = NULL, *data = NULL;
+	size_t size = 0x00, left = 0x00;
+	unsigned int len = 0x00, used = 0x00, part = 0x00;
+	libserial_parse_span_t span;
+	int ret = 0x00;
+
+	if((addr = libserial_parse_file_map(path, &size, MADV_SEQUENTIAL)) == NULL){
+		return -1;
+	}
+
+	// 未被改写的文本直接指向映射区域
+	for(data = addr, left = size; left > 0 && 0 == ret; data += used, left -= used){
+		part = (left < LIBSERIAL_PARSE_FILE_SLICE) ? (unsigned int)left : LIBSERIAL_PARSE_FILE_SLICE;
+		len  = libserial_parse_feed_nl_span(spbuf, data, part, &used, &span);
+		if(len > 0){
+			ret = func(ctx, span.ptr, span.len);
+		}
+	}
+
+	if(0 == ret && (len = libserial_parse_text_finish(spbuf)) > 0){
+		ret = func(ctx, libserial_parse_get_text(spbuf), len);
+	}
+
+	// 提前结束时丢弃解析器中的残留文本
+	if(ret){
+		libserial_parse_reset_buf(spbuf);
+	}
+
+	libserial_parse_file_unmap(addr, size);
+	return ret;
+}
@@ -0,0 +1,64 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_file.h
+* @版本		V1.0.2
+* @日期
+* @概要		批量解析日志/抓包文件中以换行符为终止符的文本(POSIX 平台)
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#ifndef __LIB_SERIAL_PARSE_FILE_H_
+#define __LIB_SERIAL_PARSE_FILE_H_
+
+#include <stddef.h>
+#include "libserial_parse_text.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 文本回调, 返回 0 继续解析, 返回非 0 停止解析
+// line 可能直接指向输入数据而不以 '\0' 结尾, 仅在回调期间有效
+typedef int (*libserial_parse_line_func_t)(void *ctx, const char *line, unsigned int len);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_parallel
+*	功能:	使用多个线程解析内存块中以换行符为终止符的文本, 按原始顺序输出
+*	参数:	spbuf: 已配置好的解析器缓冲区  data: 输入数据  size: 数据长度
+*			threads: 线程个数(0: 使用在线的处理器个数)  func: 文本回调  ctx: 回调参数
+*	返回:	-1: 申请资源失败或已挂接行驻留缓存  0: 解析完成  其他: 回调返回的非 0 值
+*	备注:	结果与逐字节调用 libserial_parse_text_nl() 并在末尾调用 libserial_parse_text_finish() 一致;
+*			spbuf 中尚未完成的文本与第一行合并, 回调在调用者线程中按顺序执行;
+*			各线程的私有解析器复制 spbuf 的配置并挂接同一个行过滤器, 回调中不能通过 spbuf 获取关键字编号;
+*			驻留编号依赖文本的先后顺序, spbuf 已挂接行驻留缓存时直接返回 -1
+*---------------------------------------------------------------------*/
+int libserial_parse_parallel(libserial_parse_buf_t *spbuf, const char *data, size_t size, unsigned int threads, libserial_parse_line_func_t func, void *ctx);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_file_parallel
+*	功能:	映射文件并使用多个线程解析以换行符为终止符的文本, 按原始顺序输出
+*	参数:	spbuf: 已配置好的解析器缓冲区  path: 文件路径
+*			threads: 线程个数(0: 使用在线的处理器个数)  func: 文本回调  ctx: 回调参数
+*	返回:	-1: 打开文件、申请资源失败或已挂接行驻留缓存  0: 解析完成  其他: 回调返回的非 0 值
+*	备注:	同 libserial_parse_parallel()
+*---------------------------------------------------------------------*/
+int libserial_parse_file_parallel(libserial_parse_buf_t *spbuf, const char *path, unsigned int threads, libserial_parse_line_func_t func, void *ctx);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_file_mmap
+*	功能:	映射文件并顺序解析以换行符为终止符的文本, 通过回调逐条输出
+*	参数:	spbuf: 已配置好的解析器缓冲区  path: 文件路径  func: 文本回调  ctx: 回调参数
+*	返回:	-1: 打开文件失败  0: 解析完成  其他: 回调返回的非 0 值
+*	备注:	结果与逐字节调用 libserial_parse_text_nl() 并在末尾调用 libserial_parse_text_finish() 一致;
+*			未被改写的文本直接指向文件映射区域(不以 '\0' 结尾), 其余文本指向 spbuf->buf;
+*			回调在解析出该文本后立即执行, 可通过 libserial_parse_get_match()、libserial_parse_get_intern() 获取其关键字编号和驻留编号
+*---------------------------------------------------------------------*/
+int libserial_parse_file_mmap(libserial_parse_buf_t *spbuf, const char *path, libserial_parse_line_func_t func, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,531 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_frame.c
+* @版本		V1.0.2
+* @日期
+* @概要		二进制帧解析(COBS、SLIP 和长度前缀), 解码的同时完成 CRC 校验, 与文本解析器使用相同的缓冲区模型
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#include <stddef.h>
+#include <string.h>
+#include "libserial_parse_frame.h"
+
+// CRC 查找表个数, 8 为 slicing-by-8(每种校验 8KB), 内存紧张的单片机可定义为 1(每种校验 1KB)
+#ifndef LIBSERIAL_PARSE_FRAME_SLICES
+#define LIBSERIAL_PARSE_FRAME_SLICES		8
+#endif
+
+#if LIBSERIAL_PARSE_FRAME_SLICES != 1 && LIBSERIAL_PARSE_FRAME_SLICES != 8
+#error "LIBSERIAL_PARSE_FRAME_SLICES must be 1 or 8"
+#endif
+
+// SLIP 特殊字符
+#define LIBSERIAL_PARSE_SLIP_END			0xC0	// 帧结束
+#define LIBSERIAL_PARSE_SLIP_ESC			0xDB	// 转义
+#define LIBSERIAL_PARSE_SLIP_ESC_END		0xDC	// 转义后代表 0xC0
+#define LIBSERIAL_PARSE_SLIP_ESC_ESC		0xDD	// 转义后代表 0xDB
+
+// 解码状态
+#define LIBSERIAL_PARSE_FRAME_ST_DATA		0		// 帧数据(COBS 为数据块或编码字节)
+#define LIBSERIAL_PARSE_FRAME_ST_ESC		1		// SLIP: 已读到转义字符
+#define LIBSERIAL_PARSE_FRAME_ST_SYNC		2		// 长度前缀: 等待同步字节
+#define LIBSERIAL_PARSE_FRAME_ST_LEN		3		// 长度前缀: 读取长度字段
+
+// 当前帧的错误
+#define LIBSERIAL_PARSE_FRAME_BAD_NONE		0		// 没有错误
+#define LIBSERIAL_PARSE_FRAME_BAD_FORMAT	1		// 编码错误
+#define LIBSERIAL_PARSE_FRAME_BAD_OVERFLOW	2		// 超出缓冲区
+
+// 帧解析对象, 存放于缓冲区末尾
+typedef struct {
+	unsigned int space;			// 解码后的帧(包含校验值)最大长度
+	unsigned int idx;			// 已解码的字节数
+	unsigned int need;			// COBS: 当前数据块剩余的字节数  长度前缀: 长度字段或帧数据剩余的字节数
+	unsigned int length;		// 长度前缀: 正在累加的长度
+	unsigned int crc;			// 校验寄存器(未异或输出值)
+	const unsigned int (*table)[256];	// 校验方式对应的查找表
+	unsigned char mode;			// 帧格式
+	unsigned char check;		// 校验方式
+	unsigned char cbytes;		// 校验值字节数
+	unsigned char st;			// 解码状态
+	unsigned char bad;			// 当前帧的错误
+	unsigned char zero;			// COBS: 下一个数据块之前需要补充 0x00
+	unsigned char lbytes;		// 长度前缀: 长度字段字节数
+	unsigned char lbig;			// 长度前缀: 长度字段高字节在前
+	int sync;					// 长度前缀: 同步字节, -1 表示没有
+	libserial_parse_frame_stats_t stats;	// 统计数据
+}frame_object_t;
+
+// 内部数据结构占用的空间(包含对齐所需的余量)
+#define LIBSERIAL_PARSE_FRAME_ALIGN			sizeof(unsigned long long)
+#define LIBSERIAL_PARSE_FRAME_OBJECT_SIZE	(sizeof(frame_object_t) + LIBSERIAL_PARSE_FRAME_ALIGN - 1)
+
+// 校验参数: 反射多项式、初始值、输出异或值以及数据连同校验值(低字节在前)一起计算后寄存器的固定余数
+#define LIBSERIAL_PARSE_CRC16_POLY			0xA001
+#define LIBSERIAL_PARSE_CRC16_INIT			0xFFFF
+#define LIBSERIAL_PARSE_CRC16_XOROUT		0x0000
+#define LIBSERIAL_PARSE_CRC16_RESIDUE		0x0000
+#define LIBSERIAL_PARSE_CRC32_POLY			0xEDB88320
+#define LIBSERIAL_PARSE_CRC32_INIT			0xFFFFFFFF
+#define LIBSERIAL_PARSE_CRC32_XOROUT		0xFFFFFFFF
+#define LIBSERIAL_PARSE_CRC32_RESIDUE		0xDEBB20E3
+
+// CRC 查找表, 第 k 个表为字节之后再经过 k 个 0x00 的校验值, 首次初始化时生成
+static unsigned int libserial_parse_crc16_table[LIBSERIAL_PARSE_FRAME_SLICES][256];
+static unsigned int libserial_parse_crc32_table[LIBSERIAL_PARSE_FRAME_SLICES][256];
+static volatile char libserial_parse_crc_ready = 0x00;
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_crc_make
+*	功能:	生成反射 CRC 的查找表
+*	参数:	table: 查找表  poly: 反射多项式
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_crc_make(unsigned int (*table)[256], unsigned int poly)
+{
+	unsigned int i = 0x00, k = 0x00, crc = 0x00;
+
+	for(i = 0; i < 256; i++){
+		crc = i;
+		for(k = 0; k < 8; k++){
+			crc = (crc >> 1) ^ (poly & (0U - (crc & 1)));
+		}
+		table[0][i] = crc;
+	}
+	for(k = 1; k < LIBSERIAL_PARSE_FRAME_SLICES; k++){
+		for(i = 0; i < 256; i++){
+			table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+		}
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_crc_tables
+*	功能:	首次调用时生成全部 CRC 查找表
+*	参数:	无需参数
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_crc_tables(void)
+{
+	if(!libserial_parse_crc_ready){
+		libserial_parse_crc_make(libserial_parse_crc16_table, LIBSERIAL_PARSE_CRC16_POLY);
+		libserial_parse_crc_make(libserial_parse_crc32_table, LIBSERIAL_PARSE_CRC32_POLY);
+		libserial_parse_crc_ready = 1;
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_crc_update
+*	功能:	以查找表计算反射 CRC(位宽不超过 32 位), 每次处理 8 字节
+*	参数:	table: 查找表  crc: 校验寄存器  data: 数据  size: 数据长度
+*	返回:	新的校验寄存器
+*	备注:	按字节组合输入数据, 不要求地址对齐, 与处理器字节序无关
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_crc_update(const unsigned int (*table)[256], unsigned int crc, const unsigned char *data, unsigned int size)
+{
+#if LIBSERIAL_PARSE_FRAME_SLICES == 8
+	unsigned int lo = 0x00, hi = 0x00;
+
+	for(; size >= 8; size -= 8, data += 8){
+		lo = crc ^ ((unsigned int)data[0] | (unsigned int)data[1] << 8 | (unsigned int)data[2] << 16 | (unsigned int)data[3] << 24);
+		hi = (unsigned int)data[4] | (unsigned int)data[5] << 8 | (unsigned int)data[6] << 16 | (unsigned int)data[7] << 24;
+		crc = table[7][lo & 0xFF] ^ table[6][(lo >> 8) & 0xFF] ^ table[5][(lo >> 16) & 0xFF] ^ table[4][lo >> 24]
+			^ table[3][hi & 0xFF] ^ table[2][(hi >> 8) & 0xFF] ^ table[1][(hi >> 16) & 0xFF] ^ table[0][hi >> 24];
+	}
+#endif
+
+	for(; size > 0; size--, data++){
+		crc = table[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	get_frame_object
+*	功能:	从缓冲区末尾获取帧解析对象的位置
+*	参数:	spbuf: 缓冲区
+*	返回:	帧解析对象
+*---------------------------------------------------------------------*/
+static inline frame_object_t *get_frame_object(libserial_parse_buf_t *spbuf)
+{
+	size_t addr = (size_t)(spbuf->buf + spbuf->total - sizeof(frame_object_t));
+	return (frame_object_t *)(addr & ~(size_t)(LIBSERIAL_PARSE_FRAME_ALIGN - 1));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_begin
+*	功能:	开始解码新的帧
+*	参数:	obj: 帧解析对象
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_frame_begin(frame_object_t *obj)
+{
+	obj->idx = 0x00;
+	obj->need = 0x00;
+	obj->length = 0x00;
+	obj->bad = LIBSERIAL_PARSE_FRAME_BAD_NONE;
+	obj->zero = 0x00;
+	obj->crc = (LIBSERIAL_PARSE_FRAME_CRC16 == obj->check) ? LIBSERIAL_PARSE_CRC16_INIT : LIBSERIAL_PARSE_CRC32_INIT;
+	obj->st = LIBSERIAL_PARSE_FRAME_ST_DATA;
+
+	// 长度前缀帧从同步字节或长度字段开始
+	if(LIBSERIAL_PARSE_FRAME_LENGTH == obj->mode){
+		obj->st = (obj->sync >= 0) ? LIBSERIAL_PARSE_FRAME_ST_SYNC : LIBSERIAL_PARSE_FRAME_ST_LEN;
+		obj->need = obj->lbytes;
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_end
+*	功能:	结束当前帧, 检查错误和校验值并开始解码新的帧
+*	参数:	obj: 帧解析对象
+*	返回:	0: 空帧或被丢弃的帧  	>0: 帧长度(不包含校验值)
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_frame_end(frame_object_t *obj)
+{
+	unsigned int residue = (LIBSERIAL_PARSE_FRAME_CRC16 == obj->check) ? LIBSERIAL_PARSE_CRC16_RESIDUE : LIBSERIAL_PARSE_CRC32_RESIDUE;
+	unsigned int len = 0x00;
+
+	if(LIBSERIAL_PARSE_FRAME_BAD_FORMAT == obj->bad){
+		obj->stats.format_errors++;
+	}else if(LIBSERIAL_PARSE_FRAME_BAD_OVERFLOW == obj->bad){
+		obj->stats.overflows++;
+	}else if(obj->idx > 0){
+		// 数据连同校验值一起计算后寄存器为固定余数即校验通过
+		if(obj->check && (obj->idx < obj->cbytes || obj->crc != residue)){
+			obj->stats.crc_errors++;
+		}else if(obj->idx > obj->cbytes){
+			obj->stats.frames++;
+			len = obj->idx - obj->cbytes;
+		}
+	}
+
+	libserial_parse_frame_begin(obj);
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_store
+*	功能:	拷贝解码得到的连续数据并更新校验寄存器
+*	参数:	obj: 帧解析对象  buf: 帧缓冲区  data: 数据  size: 数据长度
+*	返回:	无返回值
+*	备注:	当前帧已出错时丢弃数据, 超出缓冲区时标记错误
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_frame_store(frame_object_t *obj, char *buf, const unsigned char *data, unsigned int size)
+{
+	if(obj->bad){
+		return ;
+	}
+	if(size > obj->space - obj->idx){
+		obj->bad = LIBSERIAL_PARSE_FRAME_BAD_OVERFLOW;
+		return ;
+	}
+
+	memcpy(buf + obj->idx, data, size);
+	if(obj->check){
+		obj->crc = libserial_parse_crc_update(obj->table, obj->crc, (const unsigned char *)buf + obj->idx, size);
+	}
+	obj->idx += size;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_cobs
+*	功能:	解码 COBS 帧
+*	参数:	obj: 帧解析对象  buf: 帧缓冲区  data: 输入数据  size: 数据长度  end: 返回是否到达帧结束
+*	返回:	消耗的字节数
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_frame_cobs(frame_object_t *obj, char *buf, const unsigned char *data, unsigned int size, int *end)
+{
+	const unsigned char *zero = NULL;
+	unsigned int n = 0x00;
+	unsigned char code = data[0];
+
+	// 数据块: 批量拷贝到下一个 0x00 或数据块结束
+	if(obj->need > 0){
+		n = (obj->need < size) ? obj->need : size;
+		if((zero = (const unsigned char *)memchr(data, 0x00, n)) != NULL){
+			n = (unsigned int)(zero - data);
+		}
+		if(n > 0){
+			libserial_parse_frame_store(obj, buf, data, n);
+			obj->need -= n;
+			return n;
+		}
+
+		// 数据块未结束即遇到帧结束
+		obj->bad = obj->bad ? obj->bad : LIBSERIAL_PARSE_FRAME_BAD_FORMAT;
+		*end = 1;
+		return 1;
+	}
+
+	// 编码字节: 0x00 结束帧, 否则为下一个数据块的长度 + 1(0xFF 代表数据块之后没有 0x00)
+	if(0x00 == code){
+		*end = 1;
+		return 1;
+	}
+	if(obj->zero){
+		libserial_parse_frame_store(obj, buf, (const unsigned char *)"", 1);
+	}
+	obj->need = code - 1;
+	obj->zero = (0xFF != code);
+	return 1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_slip
+*	功能:	解码 SLIP 帧
+*	参数:	obj: 帧解析对象  buf: 帧缓冲区  data: 输入数据  size: 数据长度  end: 返回是否到达帧结束
+*	返回:	消耗的字节数
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_frame_slip(frame_object_t *obj, char *buf, const unsigned char *data, unsigned int size, int *end)
+{
+	unsigned int n = 0x00;
+	unsigned char ch = data[0];
+
+	// 转义字符之后只能是 ESC_END 或 ESC_ESC
+	if(LIBSERIAL_PARSE_FRAME_ST_ESC == obj->st){
+		obj->st = LIBSERIAL_PARSE_FRAME_ST_DATA;
+		if(LIBSERIAL_PARSE_SLIP_ESC_END == ch || LIBSERIAL_PARSE_SLIP_ESC_ESC == ch){
+			ch = (LIBSERIAL_PARSE_SLIP_ESC_END == ch) ? LIBSERIAL_PARSE_SLIP_END : LIBSERIAL_PARSE_SLIP_ESC;
+			libserial_parse_frame_store(obj, buf, &ch, 1);
+			return 1;
+		}
+		obj->bad = obj->bad ? obj->bad : LIBSERIAL_PARSE_FRAME_BAD_FORMAT;
+		*end = (LIBSERIAL_PARSE_SLIP_END == ch);
+		return 1;
+	}
+
+	// 批量拷贝不含特殊字符的数据
+	while(n < size && LIBSERIAL_PARSE_SLIP_END != data[n] && LIBSERIAL_PARSE_SLIP_ESC != data[n]){
+		n++;
+	}
+	if(n > 0){
+		libserial_parse_frame_store(obj, buf, data, n);
+		return n;
+	}
+
+	// 特殊字符
+	if(LIBSERIAL_PARSE_SLIP_END == ch){
+		*end = 1;
+	}else{
+		obj->st = LIBSERIAL_PARSE_FRAME_ST_ESC;
+	}
+	return 1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_length
+*	功能:	解码长度前缀帧
+*	参数:	obj: 帧解析对象  buf: 帧缓冲区  data: 输入数据  size: 数据长度  end: 返回是否到达帧结束
+*	返回:	消耗的字节数
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_frame_length(frame_object_t *obj, char *buf, const unsigned char *data, unsigned int size, int *end)
+{
+	const unsigned char *sync = NULL;
+	unsigned int n = 0x00;
+
+	switch(obj->st){
+	case LIBSERIAL_PARSE_FRAME_ST_SYNC:
+		// 丢弃同步字节之前的数据
+		if((sync = (const unsigned char *)memchr(data, obj->sync, size)) == NULL){
+			return size;
+		}
+		obj->st = LIBSERIAL_PARSE_FRAME_ST_LEN;
+		return (unsigned int)(sync - data) + 1;
+	case LIBSERIAL_PARSE_FRAME_ST_LEN:
+		// 累加长度字段
+		if(obj->lbig){
+			obj->length = (obj->length << 8) | data[0];
+		}else{
+			obj->length |= (unsigned int)data[0] << (8 * (obj->lbytes - obj->need));
+		}
+		if(--obj->need > 0){
+			return 1;
+		}
+
+		// 长度为 0 是空帧; 超出缓冲区时有同步字节则立即重新同步, 否则跳过该帧
+		obj->st = LIBSERIAL_PARSE_FRAME_ST_DATA;
+		obj->need = obj->length;
+		if(obj->length > obj->space){
+			obj->bad = LIBSERIAL_PARSE_FRAME_BAD_OVERFLOW;
+			*end = (obj->sync >= 0);
+		}
+		*end |= (0 == obj->length);
+		return 1;
+	default:
+		// 帧数据
+		n = (obj->need < size) ? obj->need : size;
+		libserial_parse_frame_store(obj, buf, data, n);
+		obj->need -= n;
+		*end = (0 == obj->need);
+		return n;
+	}
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_internal_size
+*	功能:	返回帧解析内部数据结构占用字节数
+*	参数:	无需参数
+*	返回:	内部数据结构占用字节数(包含对齐所需的余量)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_internal_size()
+{
+	return LIBSERIAL_PARSE_FRAME_OBJECT_SIZE;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_init
+*	功能:	使用用户提供的或 libserial_parse_create() 创建的缓冲区, 初始化帧解析
+*	参数:	spbuf: 缓冲区  mode: 帧格式(LIBSERIAL_PARSE_FRAME_*)  check: 校验方式(LIBSERIAL_PARSE_FRAME_CRC_*)
+*	返回:	0: 不满足最小长度要求或参数错误  >0: 解码后的帧(包含校验值)最大长度
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_init(libserial_parse_buf_t *spbuf, char mode, char check)
+{
+	frame_object_t *obj = NULL;
+
+	if(mode < LIBSERIAL_PARSE_FRAME_COBS || mode > LIBSERIAL_PARSE_FRAME_LENGTH || check < LIBSERIAL_PARSE_FRAME_CRC_NONE || check > LIBSERIAL_PARSE_FRAME_CRC32){
+		return 0;
+	}
+	if(spbuf->total < LIBSERIAL_PARSE_FRAME_OBJECT_SIZE + 1){
+		return 0;
+	}
+
+	libserial_parse_crc_tables();
+	obj = get_frame_object(spbuf);
+	memset(obj, 0x00, sizeof(frame_object_t));
+	obj->space  = spbuf->total - LIBSERIAL_PARSE_FRAME_OBJECT_SIZE;
+	obj->mode   = (unsigned char)mode;
+	obj->check  = (unsigned char)check;
+	obj->cbytes = (LIBSERIAL_PARSE_FRAME_CRC16 == check) ? 2 : (LIBSERIAL_PARSE_FRAME_CRC32 == check) ? 4 : 0;
+	obj->table  = (LIBSERIAL_PARSE_FRAME_CRC16 == check) ? (const unsigned int (*)[256])libserial_parse_crc16_table : (const unsigned int (*)[256])libserial_parse_crc32_table;
+	obj->lbytes = 2;
+	obj->lbig   = 0x00;
+	obj->sync   = -1;
+	libserial_parse_frame_begin(obj);
+	return obj->space;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_set_length
+*	功能:	设置长度前缀帧的帧头格式
+*	参数:	spbuf: 缓冲区  bytes: 长度字段字节数(1~4)  big: 长度字段是否高字节在前  
+*			sync: 长度字段之前的同步字节(0~255), -1 表示没有同步字节
+*	返回:	0: 参数错误  	1: 设置成功
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_set_length(libserial_parse_buf_t *spbuf, unsigned int bytes, char big, int sync)
+{
+	frame_object_t *obj = get_frame_object(spbuf);
+
+	if(bytes < 1 || bytes > 4 || sync < -1 || sync > 0xFF){
+		return 0;
+	}
+
+	obj->lbytes = (unsigned char)bytes;
+	obj->lbig   = (unsigned char)!!big;
+	obj->sync   = sync;
+	libserial_parse_frame_begin(obj);
+	return 1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_feed
+*	功能:	批量解码数据块, 得到一个校验通过的帧即返回
+*	参数:	spbuf: 缓冲区  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解码  	>0: 解码成功, 返回帧长度(不包含校验值)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_feed(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used)
+{
+	frame_object_t *obj = get_frame_object(spbuf);
+	const unsigned char *src = (const unsigned char *)data;
+	unsigned int i = 0x00, len = 0x00;
+	int end = 0x00;
+
+	while(i < size && 0 == len){
+		switch(obj->mode){
+		case LIBSERIAL_PARSE_FRAME_COBS:
+			i += libserial_parse_frame_cobs(obj, spbuf->buf, src + i, size - i, &end);
+			break;
+		case LIBSERIAL_PARSE_FRAME_SLIP:
+			i += libserial_parse_frame_slip(obj, spbuf->buf, src + i, size - i, &end);
+			break;
+		default:
+			i += libserial_parse_frame_length(obj, spbuf->buf, src + i, size - i, &end);
+			break;
+		}
+
+		// 帧结束, 无效的帧被丢弃后继续解码
+		if(end){
+			len = libserial_parse_frame_end(obj);
+			end = 0x00;
+		}
+	}
+
+	obj->stats.bytes += i;
+	if(used){
+		*used = i;
+	}
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_reset
+*	功能:	丢弃正在解码的帧, 从下一个字节开始解码新的帧
+*	参数:	spbuf: 缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_frame_reset(libserial_parse_buf_t *spbuf)
+{
+	libserial_parse_frame_begin(get_frame_object(spbuf));
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_get_stats
+*	功能:	获取帧解析统计
+*	参数:	spbuf: 缓冲区  stats: 返回统计数据
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_frame_get_stats(libserial_parse_buf_t *spbuf, libserial_parse_frame_stats_t *stats)
+{
+	*stats = get_frame_object(spbuf)->stats;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_clear_stats
+*	功能:	清除帧解析统计
+*	参数:	spbuf: 缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_frame_clear_stats(libserial_parse_buf_t *spbuf)
+{
+	memset(&get_frame_object(spbuf)->stats, 0x00, sizeof(libserial_parse_frame_stats_t));
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_crc
+*	功能:	计算数据的校验值, 用于发送方组帧
+*	参数:	check: 校验方式(LIBSERIAL_PARSE_FRAME_CRC_*)  data: 数据  size: 数据长度
+*	返回:	校验值, 按低字节在前追加到数据之后即可通过 libserial_parse_frame_feed() 的校验
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_crc(char check, const void *data, unsigned int size)
+{
+	libserial_parse_crc_tables();
+
+	switch(check){
+	case LIBSERIAL_PARSE_FRAME_CRC16:
+		return libserial_parse_crc_update((const unsigned int (*)[256])libserial_parse_crc16_table, LIBSERIAL_PARSE_CRC16_INIT, (const unsigned char *)data, size) ^ LIBSERIAL_PARSE_CRC16_XOROUT;
+	case LIBSERIAL_PARSE_FRAME_CRC32:
+		return libserial_parse_crc_update((const unsigned int (*)[256])libserial_parse_crc32_table, LIBSERIAL_PARSE_CRC32_INIT, (const unsigned char *)data, size) ^ LIBSERIAL_PARSE_CRC32_XOROUT;
+	default:
+		return 0;
+	}
+}
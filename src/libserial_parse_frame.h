@@ -0,0 +1,113 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_frame.h
+* @版本		V1.0.2
+* @日期
+* @概要		二进制帧解析(COBS、SLIP 和长度前缀), 解码的同时完成 CRC 校验, 与文本解析器使用相同的缓冲区模型
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#ifndef __LIB_SERIAL_PARSE_FRAME_H_
+#define __LIB_SERIAL_PARSE_FRAME_H_
+
+#include "libserial_parse_text.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIBSERIAL_PARSE_FRAME_COBS			0		// COBS 编码, 以 0x00 结束每一帧
+#define LIBSERIAL_PARSE_FRAME_SLIP			1		// SLIP 编码(RFC 1055), 以 0xC0 结束每一帧
+#define LIBSERIAL_PARSE_FRAME_LENGTH		2		// 长度前缀, 长度字段为其后的字节数(包含校验值)
+
+#define LIBSERIAL_PARSE_FRAME_CRC_NONE		0		// 不校验
+#define LIBSERIAL_PARSE_FRAME_CRC16			1		// CRC-16/MODBUS, 校验值 2 字节, 低字节在前
+#define LIBSERIAL_PARSE_FRAME_CRC32			2		// CRC-32(IEEE 802.3), 校验值 4 字节, 低字节在前
+
+// 帧解析统计
+typedef struct{
+	unsigned long long bytes;			// 输入字节数
+	unsigned long long frames;			// 校验通过的帧个数
+	unsigned long long crc_errors;		// 校验失败的帧个数
+	unsigned long long format_errors;	// 编码错误的帧个数(COBS 数据块被截断、SLIP 非法转义)
+	unsigned long long overflows;		// 超出缓冲区而被丢弃的帧个数
+}libserial_parse_frame_stats_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_internal_size
+*	功能:	返回帧解析内部数据结构占用字节数
+*	参数:	无需参数
+*	返回:	内部数据结构占用字节数(包含对齐所需的余量)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_internal_size();
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_init
+*	功能:	使用用户提供的或 libserial_parse_create() 创建的缓冲区, 初始化帧解析
+*	参数:	spbuf: 缓冲区  mode: 帧格式(LIBSERIAL_PARSE_FRAME_*)  check: 校验方式(LIBSERIAL_PARSE_FRAME_CRC_*)
+*	返回:	0: 不满足最小长度要求或参数错误  >0: 解码后的帧(包含校验值)最大长度
+*	备注:	首次调用时生成 CRC 查找表, 多线程程序应在启动其他线程前完成一次初始化;
+*			长度前缀默认为 2 字节、低字节在前、没有同步字节, 可通过 libserial_parse_frame_set_length() 修改;
+*			初始化后该缓冲区只能用于帧解析接口
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_init(libserial_parse_buf_t *spbuf, char mode, char check);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_set_length
+*	功能:	设置长度前缀帧的帧头格式
+*	参数:	spbuf: 缓冲区  bytes: 长度字段字节数(1~4)  big: 长度字段是否高字节在前  
+*			sync: 长度字段之前的同步字节(0~255), -1 表示没有同步字节
+*	返回:	0: 参数错误  	1: 设置成功
+*	备注:	丢弃正在解码的帧; 设置同步字节后, 解码出错时在下一个同步字节处重新同步
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_set_length(libserial_parse_buf_t *spbuf, unsigned int bytes, char big, int sync);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_feed
+*	功能:	批量解码数据块, 得到一个校验通过的帧即返回
+*	参数:	spbuf: 缓冲区  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解码  	>0: 解码成功, 返回帧长度(不包含校验值)
+*	备注:	帧内容位于 spbuf->buf, 可以包含 0x00, 下一次调用前有效; 空帧、编码错误和校验失败的帧被丢弃并计入统计;
+*			数据块按连续片段拷贝到缓冲区, 并在拷贝后立即对该片段计算 CRC(slicing-by-8), 不需要再次扫描整帧
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_feed(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_reset
+*	功能:	丢弃正在解码的帧, 从下一个字节开始解码新的帧
+*	参数:	spbuf: 缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_frame_reset(libserial_parse_buf_t *spbuf);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_get_stats
+*	功能:	获取帧解析统计
+*	参数:	spbuf: 缓冲区  stats: 返回统计数据
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_frame_get_stats(libserial_parse_buf_t *spbuf, libserial_parse_frame_stats_t *stats);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_clear_stats
+*	功能:	清除帧解析统计
+*	参数:	spbuf: 缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_frame_clear_stats(libserial_parse_buf_t *spbuf);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_frame_crc
+*	功能:	计算数据的校验值, 用于发送方组帧
+*	参数:	check: 校验方式(LIBSERIAL_PARSE_FRAME_CRC_*)  data: 数据  size: 数据长度
+*	返回:	校验值, 按低字节在前追加到数据之后即可通过 libserial_parse_frame_feed() 的校验
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_frame_crc(char check, const void *data, unsigned int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
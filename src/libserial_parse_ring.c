@@ -0,0 +1,316 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_ring.c
+* @版本		V1.0.2
+* @日期
+* @概要		单生产者单消费者无锁环形缓冲区, 用于在接收中断/线程与解析线程之间传递数据
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#include <stddef.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "libserial_parse_ring.h"
+
+// 缓存行大小, 生产者和消费者的索引分别独占缓存行, 避免伪共享
+#ifndef LIBSERIAL_PARSE_RING_CACHELINE
+#define LIBSERIAL_PARSE_RING_CACHELINE		64
+#endif
+
+// 单生产者单消费者队列索引, 索引自由递增, 使用时与 mask 相与
+typedef struct {
+	atomic_uint head;		// 写入索引(仅生产者修改)
+	unsigned int tcache;	// 生产者缓存的读取索引
+	char pad0[LIBSERIAL_PARSE_RING_CACHELINE - sizeof(atomic_uint) - sizeof(unsigned int)];
+	atomic_uint tail;		// 读取索引(仅消费者修改)
+	unsigned int hcache;	// 消费者缓存的写入索引
+	char pad1[LIBSERIAL_PARSE_RING_CACHELINE - sizeof(atomic_uint) - sizeof(unsigned int)];
+	unsigned int mask;		// 元素个数 - 1
+	unsigned int stride;	// 每个元素占用的字节数
+	char *data;				// 元素存储区
+}parse_spsc_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	get_spsc_object
+*	功能:	从用户提供的内存中获取队列索引的位置
+*	参数:	buf: 用户提供的内存
+*	返回:	按缓存行对齐的队列索引
+*---------------------------------------------------------------------*/
+static inline parse_spsc_t *get_spsc_object(char *buf)
+{
+	size_t addr = (size_t)buf;
+	return (parse_spsc_t *)((addr + LIBSERIAL_PARSE_RING_CACHELINE - 1) & ~(size_t)(LIBSERIAL_PARSE_RING_CACHELINE - 1));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_spsc_init
+*	功能:	在用户提供的内存中初始化队列索引, 元素个数取可容纳的最大 2 的幂
+*	参数:	buf: 用户提供的内存  total: 内存大小  stride: 每个元素占用的字节数
+*	返回:	0: 不满足最小长度要求  >0: 元素个数
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_spsc_init(char *buf, unsigned int total, unsigned int stride)
+{
+	parse_spsc_t *q = get_spsc_object(buf);
+	unsigned int head = LIBSERIAL_PARSE_RING_CACHELINE - 1 + sizeof(parse_spsc_t), count = 0x01;
+
+	if(total < head + stride){
+		return 0;
+	}
+	while(count <= (total - head) / stride / 2){
+		count <<= 1;
+	}
+
+	memset(buf, 0x00, total);
+	atomic_init(&q->head, 0);
+	atomic_init(&q->tail, 0);
+	q->tcache = 0x00;
+	q->hcache = 0x00;
+	q->mask   = count - 1;
+	q->stride = stride;
+	q->data   = (char *)(q + 1);
+
+	return count;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_spsc_free
+*	功能:	获取可写入的元素个数(仅限生产者调用)
+*	参数:	q: 队列索引  need: 需要的元素个数
+*	返回:	可写入的元素个数
+*	备注:	缓存的读取索引足够时不访问消费者的缓存行
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_spsc_free(parse_spsc_t *q, unsigned int need)
+{
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+	unsigned int room = q->mask + 1 - (head - q->tcache);
+
+	if(room < need){
+		q->tcache = atomic_load_explicit(&q->tail, memory_order_acquire);
+		room = q->mask + 1 - (head - q->tcache);
+	}
+
+	return room;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_spsc_used
+*	功能:	获取可读取的元素个数(仅限消费者调用)
+*	参数:	q: 队列索引
+*	返回:	可读取的元素个数
+*	备注:	缓存的写入索引还有数据时不访问生产者的缓存行
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_spsc_used(parse_spsc_t *q)
+{
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+	if(q->hcache == tail){
+		q->hcache = atomic_load_explicit(&q->head, memory_order_acquire);
+	}
+
+	return q->hcache - tail;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_init
+*	功能:	使用用户提供的缓冲区, 初始化字节环形缓冲区
+*	参数:	ring: 字节环形缓冲区
+*	返回:	0: 不满足最小长度要求  >0: 可存储的字节数(2 的幂)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_init(libserial_parse_ring_t *ring)
+{
+	return libserial_parse_spsc_init(ring->buf, ring->total, 1);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_push
+*	功能:	写入数据(仅限生产者调用, 可在中断中调用)
+*	参数:	ring: 字节环形缓冲区  data: 输入数据  size: 数据长度
+*	返回:	实际写入的字节数, 空间不足时只写入部分数据
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_push(libserial_parse_ring_t *ring, const char *data, unsigned int size)
+{
+	parse_spsc_t *q = get_spsc_object(ring->buf);
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+	unsigned int room = libserial_parse_spsc_free(q, size), pos = 0x00, part = 0x00;
+
+	size = (size < room) ? size : room;
+	if(0 == size){
+		return 0;
+	}
+
+	// 数据可能跨越缓冲区末尾, 分两次拷贝
+	pos  = head & q->mask;
+	part = q->mask + 1 - pos;
+	part = (size < part) ? size : part;
+	memcpy(q->data + pos, data, part);
+	memcpy(q->data, data + part, size - part);
+
+	// 数据写入完成后再发布写入索引
+	atomic_store_explicit(&q->head, head + size, memory_order_release);
+	return size;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_peek
+*	功能:	获取可以连续读取的数据(仅限消费者调用)
+*	参数:	ring: 字节环形缓冲区  data: 返回数据地址
+*	返回:	0: 没有数据  	>0: 可连续读取的字节数
+*	备注:	数据读取完毕后需调用 libserial_parse_ring_skip() 释放空间
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_peek(libserial_parse_ring_t *ring, const char **data)
+{
+	parse_spsc_t *q = get_spsc_object(ring->buf);
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+	unsigned int used = libserial_parse_spsc_used(q), pos = tail & q->mask;
+
+	*data = q->data + pos;
+	return (used < q->mask + 1 - pos) ? used : q->mask + 1 - pos;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_skip
+*	功能:	释放已读取的数据空间(仅限消费者调用)
+*	参数:	ring: 字节环形缓冲区  size: 释放的字节数(不超过 libserial_parse_ring_peek() 的返回值)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_ring_skip(libserial_parse_ring_t *ring, unsigned int size)
+{
+	parse_spsc_t *q = get_spsc_object(ring->buf);
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+	// 数据读取完成后再归还空间
+	atomic_store_explicit(&q->tail, tail + size, memory_order_release);
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_process
+*	功能:	批量取出环形缓冲区的数据, 解析后写入文本队列
+*	参数:	ring: 字节环形缓冲区  spbuf: 解析器缓冲区  lineq: 文本队列
+*			feed: libserial_parse_feed() 或 libserial_parse_feed_nl()
+*	返回:	本次写入文本队列的文本条数
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_ring_process(libserial_parse_ring_t *ring, libserial_parse_buf_t *spbuf, libserial_parse_lineq_t *lineq,
+												 unsigned int (*feed)(libserial_parse_buf_t *, const char *, unsigned int, unsigned int *))
+{
+	parse_spsc_t *lq = get_spsc_object(lineq->buf);
+	unsigned int size = 0x00, used = 0x00, len = 0x00, count = 0x00;
+	const char *data = NULL;
+
+	// 每次解析最多产生一条文本, 解析前确保文本队列有空位
+	while(libserial_parse_spsc_free(lq, 1) > 0 && (size = libserial_parse_ring_peek(ring, &data)) > 0){
+		len = feed(spbuf, data, size, &used);
+		libserial_parse_ring_skip(ring, used);
+		if(len > 0){
+			count += libserial_parse_lineq_push(lineq, libserial_parse_get_text(spbuf), len);
+		}
+	}
+
+	return count;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_drain
+*	功能:	批量取出环形缓冲区的数据, 解析以指定符号分隔或跳过的文本并写入文本队列
+*	参数:	ring: 字节环形缓冲区(作为消费者)  spbuf: 解析器缓冲区  lineq: 文本队列(作为生产者)
+*	返回:	本次写入文本队列的文本条数
+*	备注:	文本队列已满时停止读取, 未处理的数据保留在环形缓冲区中
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_drain(libserial_parse_ring_t *ring, libserial_parse_buf_t *spbuf, libserial_parse_lineq_t *lineq)
+{
+	return libserial_parse_ring_process(ring, spbuf, lineq, libserial_parse_feed);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_drain_nl  (nl -> new line)
+*	功能:	批量取出环形缓冲区的数据, 解析以换行符为终止符的文本并写入文本队列
+*	参数:	ring: 字节环形缓冲区(作为消费者)  spbuf: 解析器缓冲区  lineq: 文本队列(作为生产者)
+*	返回:	本次写入文本队列的文本条数
+*	备注:	文本队列已满时停止读取, 未处理的数据保留在环形缓冲区中
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_drain_nl(libserial_parse_ring_t *ring, libserial_parse_buf_t *spbuf, libserial_parse_lineq_t *lineq)
+{
+	return libserial_parse_ring_process(ring, spbuf, lineq, libserial_parse_feed_nl);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_init
+*	功能:	使用用户提供的缓冲区, 初始化文本队列
+*	参数:	lineq: 文本队列
+*	返回:	0: 不满足最小长度要求  >0: 可存储的文本条数(2 的幂)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_lineq_init(libserial_parse_lineq_t *lineq)
+{
+	// 每条文本: 长度 + 文本 + '\0', 按 unsigned int 对齐
+	unsigned int stride = (sizeof(unsigned int) + lineq->line + 1 + sizeof(unsigned int) - 1) & ~(unsigned int)(sizeof(unsigned int) - 1);
+	return libserial_parse_spsc_init(lineq->buf, lineq->total, stride);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_push
+*	功能:	写入一条文本(仅限生产者调用)
+*	参数:	lineq: 文本队列  text: 文本  len: 文本长度
+*	返回:	0: 队列已满  	1: 写入成功
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_lineq_push(libserial_parse_lineq_t *lineq, const char *text, unsigned int len)
+{
+	parse_spsc_t *q = get_spsc_object(lineq->buf);
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+	char *slot = NULL;
+
+	if(libserial_parse_spsc_free(q, 1) == 0){
+		return 0;
+	}
+
+	// 超出最大长度的文本被截断
+	len  = (len < lineq->line) ? len : lineq->line;
+	slot = q->data + (size_t)(head & q->mask) * q->stride;
+	memcpy(slot, &len, sizeof(len));
+	memcpy(slot + sizeof(len), text, len);
+	slot[sizeof(len) + len] = '\0';
+
+	atomic_store_explicit(&q->head, head + 1, memory_order_release);
+	return 1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_front
+*	功能:	获取队列中最早的一条文本(仅限消费者调用)
+*	参数:	lineq: 文本队列  len: 返回文本长度(可为 NULL)
+*	返回:	NULL: 队列为空  	其他: 以 '\0' 结尾的文本
+*	备注:	文本使用完毕后需调用 libserial_parse_lineq_pop() 释放
+*---------------------------------------------------------------------*/
+const char *libserial_parse_lineq_front(libserial_parse_lineq_t *lineq, unsigned int *len)
+{
+	parse_spsc_t *q = get_spsc_object(lineq->buf);
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+	char *slot = NULL;
+
+	if(libserial_parse_spsc_used(q) == 0){
+		return NULL;
+	}
+
+	slot = q->data + (size_t)(tail & q->mask) * q->stride;
+	if(len){
+		memcpy(len, slot, sizeof(*len));
+	}
+
+	return slot + sizeof(unsigned int);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_pop
+*	功能:	释放队列中最早的一条文本(仅限消费者调用)
+*	参数:	lineq: 文本队列
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_lineq_pop(libserial_parse_lineq_t *lineq)
+{
+	parse_spsc_t *q = get_spsc_object(lineq->buf);
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+	atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+	return ;
+}
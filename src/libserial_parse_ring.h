@@ -0,0 +1,122 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_ring.h
+* @版本		V1.0.2
+* @日期
+* @概要		单生产者单消费者无锁环形缓冲区, 用于在接收中断/线程与解析线程之间传递数据
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#ifndef __LIB_SERIAL_PARSE_RING_H_
+#define __LIB_SERIAL_PARSE_RING_H_
+
+#include "libserial_parse_text.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 字节环形缓冲区, 缓存大小包含了接口内部所使用的数据结构空间
+typedef struct{
+	char *buf;					// 缓存地址
+	unsigned int total;			// 缓存大小, 标明该内存空间的总长度
+}libserial_parse_ring_t;
+
+// 文本队列, 缓存大小包含了接口内部所使用的数据结构空间
+typedef struct{
+	char *buf;					// 缓存地址
+	unsigned int total;			// 缓存大小, 标明该内存空间的总长度
+	unsigned int line;			// 每条文本的最大长度(不包含 '\0'), 超出部分被截断
+}libserial_parse_lineq_t;
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_init
+*	功能:	使用用户提供的缓冲区, 初始化字节环形缓冲区
+*	参数:	ring: 字节环形缓冲区
+*	返回:	0: 不满足最小长度要求  >0: 可存储的字节数(2 的幂)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_init(libserial_parse_ring_t *ring);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_push
+*	功能:	写入数据(仅限生产者调用, 可在中断中调用)
+*	参数:	ring: 字节环形缓冲区  data: 输入数据  size: 数据长度
+*	返回:	实际写入的字节数, 空间不足时只写入部分数据
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_push(libserial_parse_ring_t *ring, const char *data, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_peek
+*	功能:	获取可以连续读取的数据(仅限消费者调用)
+*	参数:	ring: 字节环形缓冲区  data: 返回数据地址
+*	返回:	0: 没有数据  	>0: 可连续读取的字节数
+*	备注:	数据读取完毕后需调用 libserial_parse_ring_skip() 释放空间
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_peek(libserial_parse_ring_t *ring, const char **data);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_skip
+*	功能:	释放已读取的数据空间(仅限消费者调用)
+*	参数:	ring: 字节环形缓冲区  size: 释放的字节数(不超过 libserial_parse_ring_peek() 的返回值)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_ring_skip(libserial_parse_ring_t *ring, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_drain
+*	功能:	批量取出环形缓冲区的数据, 解析以指定符号分隔或跳过的文本并写入文本队列
+*	参数:	ring: 字节环形缓冲区(作为消费者)  spbuf: 解析器缓冲区  lineq: 文本队列(作为生产者)
+*	返回:	本次写入文本队列的文本条数
+*	备注:	文本队列已满时停止读取, 未处理的数据保留在环形缓冲区中
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_drain(libserial_parse_ring_t *ring, libserial_parse_buf_t *spbuf, libserial_parse_lineq_t *lineq);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ring_drain_nl  (nl -> new line)
+*	功能:	批量取出环形缓冲区的数据, 解析以换行符为终止符的文本并写入文本队列
+*	参数:	ring: 字节环形缓冲区(作为消费者)  spbuf: 解析器缓冲区  lineq: 文本队列(作为生产者)
+*	返回:	本次写入文本队列的文本条数
+*	备注:	文本队列已满时停止读取, 未处理的数据保留在环形缓冲区中
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_ring_drain_nl(libserial_parse_ring_t *ring, libserial_parse_buf_t *spbuf, libserial_parse_lineq_t *lineq);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_init
+*	功能:	使用用户提供的缓冲区, 初始化文本队列
+*	参数:	lineq: 文本队列
+*	返回:	0: 不满足最小长度要求  >0: 可存储的文本条数(2 的幂)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_lineq_init(libserial_parse_lineq_t *lineq);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_push
+*	功能:	写入一条文本(仅限生产者调用)
+*	参数:	lineq: 文本队列  text: 文本  len: 文本长度
+*	返回:	0: 队列已满  	1: 写入成功
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_lineq_push(libserial_parse_lineq_t *lineq, const char *text, unsigned int len);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_front
+*	功能:	获取队列中最早的一条文本(仅限消费者调用)
+*	参数:	lineq: 文本队列  len: 返回文本长度(可为 NULL)
+*	返回:	NULL: 队列为空  	其他: 以 '\0' 结尾的文本
+*	备注:	文本使用完毕后需调用 libserial_parse_lineq_pop() 释放
+*---------------------------------------------------------------------*/
+const char *libserial_parse_lineq_front(libserial_parse_lineq_t *lineq, unsigned int *len);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_lineq_pop
+*	功能:	释放队列中最早的一条文本(仅限消费者调用)
+*	参数:	lineq: 文本队列
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_lineq_pop(libserial_parse_lineq_t *lineq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,531 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_serial.c
+* @版本		V1.0.2
+* @日期
+* @概要		基于 epoll 同时读取多个串口(或管道、伪终端), 数据直接交给对应的解析器并通过回调输出文本(Linux 平台)
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/epoll.h>
+#ifdef LIBSERIAL_PARSE_IDLE
+#include <time.h>
+#include <sys/timerfd.h>
+#endif
+#include "libserial_parse_serial.h"
+
+// 每个端口暂存区的默认大小
+#ifndef LIBSERIAL_PARSE_SERIAL_STAGE
+#define LIBSERIAL_PARSE_SERIAL_STAGE		4096
+#endif
+
+// 单次 epoll_wait() 最多返回的事件个数
+#ifndef LIBSERIAL_PARSE_SERIAL_EVENTS
+#define LIBSERIAL_PARSE_SERIAL_EVENTS		16
+#endif
+
+#ifdef LIBSERIAL_PARSE_IDLE
+// 空闲超时定时器在 epoll 中的标识(区别于端口号)
+#define LIBSERIAL_PARSE_SERIAL_TIMER		0xFFFFFFFF
+#endif
+
+// 端口信息
+typedef struct {
+	int fd;								// 文件描述符, -1 表示未使用
+	int owned;							// 是否由读取器打开(移出时关闭)
+	int mode;							// 文本输出方式
+	libserial_parse_buf_t *spbuf;		// 解析器缓冲区
+	libserial_parse_handler_t handler;	// 事件回调
+	char *stage;						// 暂存区, read() 直接写入
+	unsigned int off;					// 暂存区中尚未解析的数据位置
+	unsigned int len;					// 暂存区中尚未解析的数据长度
+}parse_port_t;
+
+// 串口读取器
+struct libserial_parse_serial {
+	int epfd;					// epoll 文件描述符
+#ifdef LIBSERIAL_PARSE_IDLE
+	int tfd;					// 空闲超时定时器(timerfd)
+	unsigned long long armed;	// 定时器的到期时间(毫秒), 0 表示未启动
+#endif
+	unsigned int stage;			// 每个端口的暂存区大小
+	unsigned int pending;		// 暂存区中仍有数据的端口个数
+	parse_port_t *port;			// 端口列表
+	unsigned int nport;			// 端口列表容量
+};
+
+// 波特率对照表
+static const struct {
+	unsigned int baud;
+	speed_t speed;
+}libserial_parse_serial_speed[] = {
+	{1200, B1200}, {2400, B2400}, {4800, B4800}, {9600, B9600}, {19200, B19200},
+	{38400, B38400}, {57600, B57600}, {115200, B115200}, {230400, B230400},
+#ifdef B460800
+	{460800, B460800},
+#endif
+#ifdef B921600
+	{921600, B921600},
+#endif
+#ifdef B1000000
+	{1000000, B1000000},
+#endif
+#ifdef B2000000
+	{2000000, B2000000},
+#endif
+#ifdef B4000000
+	{4000000, B4000000},
+#endif
+};
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_create
+*	功能:	创建串口读取器
+*	参数:	stage: 每个端口的暂存区大小, 即单次 read() 的最大长度(0: 使用默认值)
+*	返回:	NULL: 申请资源失败		其他: 串口读取器
+*---------------------------------------------------------------------*/
+libserial_parse_serial_t *libserial_parse_serial_create(unsigned int stage)
+{
+	libserial_parse_serial_t *serial = NULL;
+#ifdef LIBSERIAL_PARSE_IDLE
+	struct epoll_event ev;
+#endif
+
+	if((serial = (libserial_parse_serial_t *)calloc(1, sizeof(libserial_parse_serial_t))) == NULL){
+		return NULL;
+	}
+	if((serial->epfd = epoll_create1(EPOLL_CLOEXEC)) < 0){
+		free(serial);
+		return NULL;
+	}
+#ifdef LIBSERIAL_PARSE_IDLE
+	if((serial->tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) < 0){
+		close(serial->epfd);
+		free(serial);
+		return NULL;
+	}
+
+	memset(&ev, 0x00, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.u32 = LIBSERIAL_PARSE_SERIAL_TIMER;
+	if(epoll_ctl(serial->epfd, EPOLL_CTL_ADD, serial->tfd, &ev) < 0){
+		close(serial->tfd);
+		close(serial->epfd);
+		free(serial);
+		return NULL;
+	}
+#endif
+
+	serial->stage = stage ? stage : LIBSERIAL_PARSE_SERIAL_STAGE;
+	return serial;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_release
+*	功能:	释放串口读取器, 关闭由 libserial_parse_serial_open() 打开的设备
+*	参数:	serial: 串口读取器
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_serial_release(libserial_parse_serial_t *serial)
+{
+	unsigned int i = 0x00;
+
+	if(serial){
+		for(i = 0; i < serial->nport; i++){
+			libserial_parse_serial_remove(serial, (int)i);
+			free(serial->port[i].stage);
+		}
+#ifdef LIBSERIAL_PARSE_IDLE
+		close(serial->tfd);
+#endif
+		close(serial->epfd);
+		free(serial->port);
+		free(serial);
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_set_raw
+*	功能:	将终端设置为原始模式(8N1, 无回显, 无流控, 不转换字符)并设置波特率
+*	参数:	fd: 终端设备的文件描述符  baud: 波特率(0: 保持当前波特率)
+*	返回:	-1: 不是终端设备、不支持的波特率或设置失败  0: 设置成功
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_set_raw(int fd, unsigned int baud)
+{
+	struct termios tio;
+	unsigned int i = 0x00;
+
+	if(tcgetattr(fd, &tio) < 0){
+		return -1;
+	}
+
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+	tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+	tio.c_cc[VMIN]  = 1;
+	tio.c_cc[VTIME] = 0;
+
+	if(baud > 0){
+		for(i = 0; i < sizeof(libserial_parse_serial_speed) / sizeof(libserial_parse_serial_speed[0]); i++){
+			if(libserial_parse_serial_speed[i].baud == baud){
+				break;
+			}
+		}
+		if(i >= sizeof(libserial_parse_serial_speed) / sizeof(libserial_parse_serial_speed[0])){
+			return -1;
+		}
+		cfsetispeed(&tio, libserial_parse_serial_speed[i].speed);
+		cfsetospeed(&tio, libserial_parse_serial_speed[i].speed);
+	}
+
+	return (tcsetattr(fd, TCSANOW, &tio) < 0) ? -1 : 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_insert
+*	功能:	为文件描述符分配端口并注册到 epoll
+*	参数:	serial: 串口读取器  fd: 文件描述符  owned: 是否由读取器打开
+*			spbuf: 解析器缓冲区  mode: 文本输出方式  handler: 事件回调
+*	返回:	-1: 申请资源失败  >=0: 端口号
+*	备注:	优先复用已移出的端口, 暂存区在端口首次使用时申请
+*---------------------------------------------------------------------*/
+static int libserial_parse_serial_insert(libserial_parse_serial_t *serial, int fd, int owned, libserial_parse_buf_t *spbuf, int mode, const libserial_parse_handler_t *handler)
+{
+	struct epoll_event ev;
+	parse_port_t *port = NULL;
+	unsigned int i = 0x00, n = 0x00;
+	int flags = 0x00;
+
+	for(i = 0; i < serial->nport && serial->port[i].fd >= 0; i++);
+	if(i >= serial->nport){
+		n = serial->nport ? serial->nport * 2 : 4;
+		if((port = (parse_port_t *)realloc(serial->port, n * sizeof(parse_port_t))) == NULL){
+			return -1;
+		}
+		memset(port + serial->nport, 0x00, (n - serial->nport) * sizeof(parse_port_t));
+		for(i = serial->nport; i < n; i++){
+			port[i].fd = -1;
+		}
+		i = serial->nport;
+		serial->port  = port;
+		serial->nport = n;
+	}
+
+	port = &serial->port[i];
+	if(NULL == port->stage && (port->stage = (char *)malloc(serial->stage)) == NULL){
+		return -1;
+	}
+	if((flags = fcntl(fd, F_GETFL)) < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0){
+		return -1;
+	}
+
+	memset(&ev, 0x00, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.u32 = i;
+	if(epoll_ctl(serial->epfd, EPOLL_CTL_ADD, fd, &ev) < 0){
+		return -1;
+	}
+
+	port->fd	  = fd;
+	port->owned   = owned;
+	port->mode	  = mode;
+	port->spbuf   = spbuf;
+	port->handler = *handler;
+	port->off	  = 0x00;
+	port->len	  = 0x00;
+	return (int)i;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_open
+*	功能:	打开串口设备, 设置为原始模式后加入串口读取器
+*	参数:	serial: 串口读取器  path: 设备路径  baud: 波特率(0: 保持当前波特率)
+*			spbuf: 已配置好的解析器缓冲区  mode: 文本输出方式  handler: 事件回调
+*	返回:	-1: 打开或设置设备失败  >=0: 端口号
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_open(libserial_parse_serial_t *serial, const char *path, unsigned int baud, libserial_parse_buf_t *spbuf, int mode, const libserial_parse_handler_t *handler)
+{
+	int fd = -1, port = -1;
+
+	if((fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC)) < 0){
+		return -1;
+	}
+	if(isatty(fd) && libserial_parse_serial_set_raw(fd, baud) < 0){
+		close(fd);
+		return -1;
+	}
+	if((port = libserial_parse_serial_insert(serial, fd, 1, spbuf, mode, handler)) < 0){
+		close(fd);
+		return -1;
+	}
+
+	return port;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_add
+*	功能:	将已打开的文件描述符加入串口读取器
+*	参数:	serial: 串口读取器  fd: 文件描述符
+*			spbuf: 已配置好的解析器缓冲区  mode: 文本输出方式  handler: 事件回调
+*	返回:	-1: 申请资源失败  >=0: 端口号
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_add(libserial_parse_serial_t *serial, int fd, libserial_parse_buf_t *spbuf, int mode, const libserial_parse_handler_t *handler)
+{
+	return libserial_parse_serial_insert(serial, fd, 0, spbuf, mode, handler);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_remove
+*	功能:	将端口移出串口读取器, 由 libserial_parse_serial_open() 打开的设备同时被关闭
+*	参数:	serial: 串口读取器  port: 端口号
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_serial_remove(libserial_parse_serial_t *serial, int port)
+{
+	parse_port_t *p = NULL;
+
+	if(port < 0 || (unsigned int)port >= serial->nport || serial->port[port].fd < 0){
+		return ;
+	}
+
+	p = &serial->port[port];
+	epoll_ctl(serial->epfd, EPOLL_CTL_DEL, p->fd, NULL);
+	if(p->owned){
+		close(p->fd);
+	}
+	if(p->len > 0){
+		serial->pending--;
+	}
+	p->fd  = -1;
+	p->len = 0x00;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_fd
+*	功能:	获取端口的文件描述符
+*	参数:	serial: 串口读取器  port: 端口号
+*	返回:	-1: 端口不存在或已关闭  >=0: 文件描述符
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_fd(libserial_parse_serial_t *serial, int port)
+{
+	if(port < 0 || (unsigned int)port >= serial->nport){
+		return -1;
+	}
+	return serial->port[port].fd;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_feed
+*	功能:	将暂存区中的数据交给端口的解析器
+*	参数:	serial: 串口读取器  port: 端口号  off: 数据位置  len: 数据长度
+*	返回:	0: 数据已全部处理  其他: 回调返回的非 0 值, 剩余数据保留在暂存区
+*	备注:	回调中可能加入或移出端口, 返回后重新获取端口信息
+*---------------------------------------------------------------------*/
+static int libserial_parse_serial_feed(libserial_parse_serial_t *serial, int port, unsigned int off, unsigned int len)
+{
+	parse_port_t *p = &serial->port[port];
+	libserial_parse_handler_t handler = p->handler;
+	unsigned int used = 0x00;
+	int ret = 0x00;
+
+	if(LIBSERIAL_PARSE_SERIAL_NL == p->mode){
+		ret = libserial_parse_push_nl(p->spbuf, &handler, p->stage + off, len, &used);
+	}else{
+		ret = libserial_parse_push(p->spbuf, &handler, p->stage + off, len, &used);
+	}
+
+	p = &serial->port[port];
+	if(p->fd < 0){
+		return ret;
+	}
+	if(p->len > 0){
+		serial->pending--;
+	}
+	p->off = off + used;
+	p->len = len - used;
+	if(p->len > 0){
+		serial->pending++;
+	}
+
+	return ret;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_read
+*	功能:	读取端口中的全部数据并交给解析器
+*	参数:	serial: 串口读取器  port: 端口号
+*	返回:	0: 数据已全部处理  其他: 回调返回的非 0 值
+*	备注:	读到文件结束或读取出错时输出剩余文本并移出端口
+*---------------------------------------------------------------------*/
+static int libserial_parse_serial_read(libserial_parse_serial_t *serial, int port)
+{
+	parse_port_t *p = &serial->port[port];
+	libserial_parse_handler_t handler;
+	ssize_t n = 0x00;
+	int ret = 0x00;
+
+	while(p->fd >= 0 && 0 == p->len){
+		n = read(p->fd, p->stage, serial->stage);
+		if(n > 0){
+			if((ret = libserial_parse_serial_feed(serial, port, 0, (unsigned int)n)) != 0 || (size_t)n < serial->stage){
+				return ret;
+			}
+			p = &serial->port[port];
+			continue;
+		}
+		if(n < 0 && EINTR == errno){
+			continue;
+		}
+		if(n < 0 && (EAGAIN == errno || EWOULDBLOCK == errno)){
+			break;
+		}
+
+		// 文件结束(对端关闭)或读取出错(如伪终端对端关闭时的 EIO)
+		handler = p->handler;
+		libserial_parse_serial_remove(serial, port);
+		return libserial_parse_push_finish(p->spbuf, &handler);
+	}
+
+	return ret;
+}
+
+#ifdef LIBSERIAL_PARSE_IDLE
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_now
+*	功能:	获取单调时钟的当前时间
+*	参数:	无需参数
+*	返回:	当前时间(毫秒)
+*---------------------------------------------------------------------*/
+static unsigned long long libserial_parse_serial_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000 + (unsigned long long)ts.tv_nsec / 1000000;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_arm
+*	功能:	设置空闲超时定时器的到期时间
+*	参数:	serial: 串口读取器  when: 到期时间(单调时钟, 毫秒)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_serial_arm(libserial_parse_serial_t *serial, unsigned long long when)
+{
+	struct itimerspec its;
+
+	memset(&its, 0x00, sizeof(its));
+	its.it_value.tv_sec  = (time_t)(when / 1000);
+	its.it_value.tv_nsec = (long)(when % 1000) * 1000000;
+	if(timerfd_settime(serial->tfd, TFD_TIMER_ABSTIME, &its, NULL) == 0){
+		serial->armed = when;
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_idle
+*	功能:	检查各端口的空闲超时, 输出超时的不完整文本并按最早的超时时间设置定时器
+*	参数:	serial: 串口读取器
+*	返回:	0: 处理完成  其他: 回调返回的非 0 值
+*	备注:	暂存区中仍有数据的端口不检查; 定时器只在到期时间提前时重新设置, 
+*			提前到期时重新计算即可; 回调返回非 0 值时定时器立即到期, 其余端口在下一次调用时处理
+*---------------------------------------------------------------------*/
+static int libserial_parse_serial_idle(libserial_parse_serial_t *serial)
+{
+	unsigned long long now = libserial_parse_serial_now(), cnt = 0x00;
+	libserial_parse_handler_t handler;
+	unsigned int i = 0x00, wait = 0x00, left = 0x00;
+	parse_port_t *p = NULL;
+	int ret = 0x00;
+
+	// 定时器已到期, 清除其可读状态
+	if(serial->armed > 0 && serial->armed <= now){
+		if(read(serial->tfd, &cnt, sizeof(cnt)) < 0){
+			cnt = 0x00;
+		}
+		serial->armed = 0x00;
+	}
+
+	for(i = 0; i < serial->nport; i++){
+		p = &serial->port[i];
+		if(p->fd < 0 || p->len > 0){
+			continue;
+		}
+		handler = p->handler;
+		if((ret = libserial_parse_push_poll(p->spbuf, &handler, (unsigned int)now)) != 0){
+			libserial_parse_serial_arm(serial, now);
+			return ret;
+		}
+		p = &serial->port[i];
+		if(p->fd >= 0 && (left = libserial_parse_get_idle(p->spbuf, (unsigned int)now)) > 0 && (0 == wait || left < wait)){
+			wait = left;
+		}
+	}
+
+	if(wait > 0 && (0 == serial->armed || now + wait < serial->armed)){
+		libserial_parse_serial_arm(serial, now + wait);
+	}
+	return 0;
+}
+
+#define LIBSERIAL_PARSE_SERIAL_IS_TIMER(u32)			(LIBSERIAL_PARSE_SERIAL_TIMER == (u32))
+#define LIBSERIAL_PARSE_SERIAL_EXPIRE(serial)			libserial_parse_serial_arm(serial, libserial_parse_serial_now())
+#define LIBSERIAL_PARSE_SERIAL_IDLE(serial)				libserial_parse_serial_idle(serial)
+#else
+#define LIBSERIAL_PARSE_SERIAL_IS_TIMER(u32)			0
+#define LIBSERIAL_PARSE_SERIAL_EXPIRE(serial)			((void)0)
+#define LIBSERIAL_PARSE_SERIAL_IDLE(serial)				0
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_poll
+*	功能:	等待任意端口有数据可读, 读取后交给对应的解析器, 每得到一个文本即调用该端口的回调
+*	参数:	serial: 串口读取器  timeout: 最长等待时间(毫秒, -1: 一直等待, 0: 不等待)
+*	返回:	-1: 等待失败  0: 超时或数据已全部处理  其他: 回调返回的非 0 值
+*	备注:	定义 LIBSERIAL_PARSE_IDLE 且解析器设置了空闲超时(毫秒)时, 不完整的文本超时后由内部定时器唤醒并输出; 
+*			回调返回非 0 值时定时器立即到期, 保证下一次调用不会因等待数据而错过超时检查
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_poll(libserial_parse_serial_t *serial, int timeout)
+{
+	struct epoll_event ev[LIBSERIAL_PARSE_SERIAL_EVENTS];
+	parse_port_t *p = NULL;
+	unsigned int i = 0x00;
+	int n = 0x00, k = 0x00, ret = 0x00;
+
+	// 先处理上次回调停止后暂存区中剩余的数据
+	for(i = 0; i < serial->nport && serial->pending > 0; i++){
+		p = &serial->port[i];
+		if(p->fd >= 0 && p->len > 0 && (ret = libserial_parse_serial_feed(serial, (int)i, p->off, p->len)) != 0){
+			LIBSERIAL_PARSE_SERIAL_EXPIRE(serial);
+			return ret;
+		}
+	}
+
+	if((n = epoll_wait(serial->epfd, ev, LIBSERIAL_PARSE_SERIAL_EVENTS, timeout)) < 0){
+		return (EINTR == errno) ? 0 : -1;
+	}
+
+	for(k = 0; k < n; k++){
+		if(LIBSERIAL_PARSE_SERIAL_IS_TIMER(ev[k].data.u32)){
+			continue;
+		}
+		if((ret = libserial_parse_serial_read(serial, (int)ev[k].data.u32)) != 0){
+			LIBSERIAL_PARSE_SERIAL_EXPIRE(serial);
+			return ret;
+		}
+	}
+
+	// 记录收到数据的时间, 输出空闲超时的不完整文本
+	return LIBSERIAL_PARSE_SERIAL_IDLE(serial);
+}
@@ -0,0 +1,106 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_serial.h
+* @版本		V1.0.2
+* @日期
+* @概要		基于 epoll 同时读取多个串口(或管道、伪终端), 数据直接交给对应的解析器并通过回调输出文本(Linux 平台)
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#ifndef __LIB_SERIAL_PARSE_SERIAL_H_
+#define __LIB_SERIAL_PARSE_SERIAL_H_
+
+#include "libserial_parse_text.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 串口读取器, 由 libserial_parse_serial_create() 创建
+typedef struct libserial_parse_serial libserial_parse_serial_t;
+
+#define LIBSERIAL_PARSE_SERIAL_DIVIDE		0		// 按解析器配置的分隔字符输出文本(libserial_parse_push())
+#define LIBSERIAL_PARSE_SERIAL_NL			1		// 按换行符输出文本(libserial_parse_push_nl())
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_create
+*	功能:	创建串口读取器
+*	参数:	stage: 每个端口的暂存区大小, 即单次 read() 的最大长度(0: 使用默认值 4096)
+*	返回:	NULL: 申请资源失败		其他: 串口读取器
+*---------------------------------------------------------------------*/
+libserial_parse_serial_t *libserial_parse_serial_create(unsigned int stage);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_release
+*	功能:	释放串口读取器, 关闭由 libserial_parse_serial_open() 打开的设备
+*	参数:	serial: 串口读取器
+*	返回:	无返回值
+*	备注:	不释放各端口的解析器, 由 libserial_parse_serial_add() 加入的文件描述符不会被关闭
+*---------------------------------------------------------------------*/
+void libserial_parse_serial_release(libserial_parse_serial_t *serial);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_set_raw
+*	功能:	将终端设置为原始模式(8N1, 无回显, 无流控, 不转换字符)并设置波特率
+*	参数:	fd: 终端设备的文件描述符  baud: 波特率, 如 115200(0: 保持当前波特率)
+*	返回:	-1: 不是终端设备、不支持的波特率或设置失败  0: 设置成功
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_set_raw(int fd, unsigned int baud);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_open
+*	功能:	打开串口设备, 设置为原始模式后加入串口读取器
+*	参数:	serial: 串口读取器  path: 设备路径, 如 "/dev/ttyUSB0"  baud: 波特率(0: 保持当前波特率)
+*			spbuf: 已配置好的解析器缓冲区  mode: LIBSERIAL_PARSE_SERIAL_DIVIDE 或 LIBSERIAL_PARSE_SERIAL_NL
+*			handler: 事件回调(内容被复制保存)
+*	返回:	-1: 打开或设置设备失败  >=0: 端口号
+*	备注:	非终端设备(如命名管道)不设置原始模式, 直接加入
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_open(libserial_parse_serial_t *serial, const char *path, unsigned int baud, libserial_parse_buf_t *spbuf, int mode, const libserial_parse_handler_t *handler);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_add
+*	功能:	将已打开的文件描述符(串口、管道、伪终端等)加入串口读取器
+*	参数:	serial: 串口读取器  fd: 文件描述符(被设置为非阻塞方式)
+*			spbuf: 已配置好的解析器缓冲区  mode: LIBSERIAL_PARSE_SERIAL_DIVIDE 或 LIBSERIAL_PARSE_SERIAL_NL
+*			handler: 事件回调(内容被复制保存)
+*	返回:	-1: 申请资源失败  >=0: 端口号
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_add(libserial_parse_serial_t *serial, int fd, libserial_parse_buf_t *spbuf, int mode, const libserial_parse_handler_t *handler);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_remove
+*	功能:	将端口移出串口读取器, 由 libserial_parse_serial_open() 打开的设备同时被关闭
+*	参数:	serial: 串口读取器  port: 端口号
+*	返回:	无返回值
+*	备注:	暂存区中尚未解析的数据被丢弃, 解析器中尚未完成的文本保持不变
+*---------------------------------------------------------------------*/
+void libserial_parse_serial_remove(libserial_parse_serial_t *serial, int port);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_fd
+*	功能:	获取端口的文件描述符
+*	参数:	serial: 串口读取器  port: 端口号
+*	返回:	-1: 端口不存在或已关闭  >=0: 文件描述符
+*	备注:	读到文件结束或读取出错的端口会被自动移出, 剩余文本通过 libserial_parse_push_finish() 输出
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_fd(libserial_parse_serial_t *serial, int port);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_serial_poll
+*	功能:	等待任意端口有数据可读, 读取后交给对应的解析器, 每得到一个文本即调用该端口的回调
+*	参数:	serial: 串口读取器  timeout: 最长等待时间(毫秒, -1: 一直等待, 0: 不等待)
+*	返回:	-1: 等待失败  0: 超时或数据已全部处理  其他: 回调返回的非 0 值
+*	备注:	回调返回非 0 值时立即返回, 暂存区中剩余的数据在下一次调用时优先处理(不等待);
+*			定义 LIBSERIAL_PARSE_IDLE 且端口的解析器通过 libserial_parse_set_idle() 设置了空闲超时(单位为毫秒)时, 
+*			不完整的文本(如没有换行的提示符)超时后由内部定时器唤醒, 通过该端口的回调输出
+*---------------------------------------------------------------------*/
+int libserial_parse_serial_poll(libserial_parse_serial_t *serial, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,13 +9,59 @@
 * @注意  	All rights reserved
 ******************************************************************************
 */
-#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 #include "libserial_parse_text.h"
 
+#ifdef LIBSERIAL_PARSE_STATS
+#include <stdatomic.h>
+#endif
+
+// 批量扫描内核选择(编译期), 定义 LIBSERIAL_PARSE_NO_SIMD 可强制使用通用的 SWAR 实现
+#if defined(LIBSERIAL_PARSE_NO_SIMD)
+#define LIBSERIAL_PARSE_SCAN_SWAR
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define LIBSERIAL_PARSE_SCAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIBSERIAL_PARSE_SCAN_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LIBSERIAL_PARSE_SCAN_NEON
+#else
+#define LIBSERIAL_PARSE_SCAN_SWAR
+#endif
+
+// 批量扫描最多同时比较的字符个数, 超出后使用位图逐字节查表
+#define LIBSERIAL_PARSE_SCAN_MAX			8
+
+// 字符集合位图(256 位)操作
+#define LIBSERIAL_PARSE_MAP_SET(map, ch)	((map)[(unsigned char)(ch) >> 3] |= (unsigned char)(1 << ((unsigned char)(ch) & 0x07)))
+#define LIBSERIAL_PARSE_MAP_TEST(map, ch)	((map)[(unsigned char)(ch) >> 3] & (1 << ((unsigned char)(ch) & 0x07)))
+
+// 字符转换表生成(编译期展开 256 项)
+#define LIBSERIAL_PARSE_TO_SAME(c)			(c)
+#define LIBSERIAL_PARSE_TO_LOWER(c)			(((c) >= 'A' && (c) <= 'Z') ? (c) + 0x20 : (c))
+#define LIBSERIAL_PARSE_TO_UPPER(c)			(((c) >= 'a' && (c) <= 'z') ? (c) - 0x20 : (c))
+#define LIBSERIAL_PARSE_TABLE4(f, n)		f(n), f((n) + 1), f((n) + 2), f((n) + 3)
+#define LIBSERIAL_PARSE_TABLE16(f, n)		LIBSERIAL_PARSE_TABLE4(f, n), LIBSERIAL_PARSE_TABLE4(f, (n) + 4), LIBSERIAL_PARSE_TABLE4(f, (n) + 8), LIBSERIAL_PARSE_TABLE4(f, (n) + 12)
+#define LIBSERIAL_PARSE_TABLE64(f, n)		LIBSERIAL_PARSE_TABLE16(f, n), LIBSERIAL_PARSE_TABLE16(f, (n) + 16), LIBSERIAL_PARSE_TABLE16(f, (n) + 32), LIBSERIAL_PARSE_TABLE16(f, (n) + 48)
+#define LIBSERIAL_PARSE_TABLE256(f)			LIBSERIAL_PARSE_TABLE64(f, 0), LIBSERIAL_PARSE_TABLE64(f, 64), LIBSERIAL_PARSE_TABLE64(f, 128), LIBSERIAL_PARSE_TABLE64(f, 192)
+
+// 与区域设置无关的 ASCII 转换表
+static const unsigned char libserial_parse_same_table[256]  = {LIBSERIAL_PARSE_TABLE256(LIBSERIAL_PARSE_TO_SAME)};
+static const unsigned char libserial_parse_lower_table[256] = {LIBSERIAL_PARSE_TABLE256(LIBSERIAL_PARSE_TO_LOWER)};
+static const unsigned char libserial_parse_upper_table[256] = {LIBSERIAL_PARSE_TABLE256(LIBSERIAL_PARSE_TO_UPPER)};
+
+// 内部数据结构默认按 1 字节紧凑排列, 以减少静态内存占用;
+// 定义 LIBSERIAL_PARSE_ALIGNED 后改为自然对齐, 解析器对象按 LIBSERIAL_PARSE_ALIGN 字节对齐存放于缓冲区末尾,
+// 热点字段(缓冲区、状态、转换表和停止字符)位于对象的第一个缓存行内, 对象地址由 libserial_parse_init() 记录在 spbuf->obj 中
+// LIBSERIAL_PARSE_ALIGN 的默认值定义在头文件中
 // 缓冲区描述信息
+#ifndef LIBSERIAL_PARSE_ALIGNED
 #pragma pack(1)
+#endif
 typedef struct {
 	char *buf;				// 存储数据的位置
 	unsigned int   idx;		// 存储数据的索引
@@ -25,29 +71,202 @@ typedef struct {
 #pragma pack()	
 
 // 解析器配置信息
+#ifndef LIBSERIAL_PARSE_ALIGNED
 #pragma pack(1)
+#endif
 typedef struct {
-	char shift; 			// 转换为大写字母(0:不做转换 1:转换为小写字母 2:转换为大写字母)
-	char divide;			// 存储用户配置的分隔字符
-	char ignore;			// 存储用户配置的忽略字符
+	const unsigned char *table;	// 当前使用的 256 字节转换表(不做转换时为恒等表)
+	char shift; 			// 转换为大写字母(0:不做转换 1:转换为小写字母 2:转换为大写字母 3:用户转换表)
+	char escape;			// 是否解码双引号内的转义序列
+	unsigned char nstop;	// 批量扫描需要停下的字符个数(超出 LIBSERIAL_PARSE_SCAN_MAX 则查位图)
+	char stop[LIBSERIAL_PARSE_SCAN_MAX];	// 批量扫描需要停下的字符(双引号、启用转义时的反斜杠、分隔字符和忽略字符)
+	unsigned char divide[32];	// 存储用户配置的分隔字符集合位图
+	unsigned char ignore[32];	// 存储用户配置的忽略字符集合位图
 }parse_config_t;
 #pragma pack()	
 
+#ifndef LIBSERIAL_PARSE_ALIGNED
 #pragma pack(1)
+#endif
 typedef struct {
 	char dqu:1;				// 双引号处理
+	unsigned char ovf:1;	// 上一个文本因缓冲区已满被截断
+	unsigned char full:1;	// 当前文本已达到增长上限, 丢弃剩余数据直至分隔字符
+	unsigned char esc:2;	// 转义序列解码状态
+	unsigned char hex:4;	// \xNN 转义已读到的第一个十六进制数字
+	char end;				// 结束上一个文本的分隔字符
 }parse_status_t;
 #pragma pack()
 
+// 转义序列解码状态
+#define LIBSERIAL_PARSE_ESC_NONE			0		// 不在转义序列中
+#define LIBSERIAL_PARSE_ESC_START			1		// 已读到反斜杠
+#define LIBSERIAL_PARSE_ESC_HEX1			2		// 已读到 \x, 等待第一个十六进制数字
+#define LIBSERIAL_PARSE_ESC_HEX2			3		// 等待第二个十六进制数字
+
+#ifdef LIBSERIAL_PARSE_FILTER
+// 行过滤状态
+#ifndef LIBSERIAL_PARSE_ALIGNED
+#pragma pack(1)
+#endif
+typedef struct {
+	const libserial_parse_filter_t *filter;	// 挂接的行过滤器(NULL 表示未挂接)
+	unsigned int state;		// 自动机当前状态(状态转移表内的偏移)
+	unsigned short hit;		// 当前文本匹配到的关键字编号 + 1 (0 表示尚未匹配)
+	unsigned short last;	// 上一个返回的文本匹配到的关键字编号 + 1
+}parse_filter_t;
+#pragma pack()
+#endif
+
+#ifdef LIBSERIAL_PARSE_INTERN
+// 行驻留状态
+#ifndef LIBSERIAL_PARSE_ALIGNED
+#pragma pack(1)
+#endif
+typedef struct {
+	libserial_parse_intern_t *cache;	// 挂接的行驻留缓存(NULL 表示未挂接)
+	unsigned int hash;		// 当前文本前 pos 字节的哈希值
+	unsigned int pos;		// 已计入哈希的字节数
+	int id;					// 上一个返回的文本的驻留编号(-1 表示未驻留)
+	unsigned char seen;		// 上一个返回的文本此前已驻留
+}parse_intern_t;
+#pragma pack()
+#endif
+
+#ifdef LIBSERIAL_PARSE_IDLE
+// 空闲超时状态
+#ifndef LIBSERIAL_PARSE_ALIGNED
+#pragma pack(1)
+#endif
+typedef struct {
+	libserial_parse_clock_func_t clock;	// 时钟回调(NULL 表示由 libserial_parse_poll() 记录时间)
+	void *ctx;				// 时钟回调的参数
+	unsigned int timeout;	// 空闲超时时间, 0 表示未启用
+	unsigned int last;		// 最后收到数据的时间
+	unsigned char active;	// 上一次 libserial_parse_poll() 之后调用过解析接口(未挂接时钟回调时使用)
+}parse_idle_t;
+#pragma pack()
+#endif
+
+#ifdef LIBSERIAL_PARSE_GROW
+// 连续多少个较短(不足缓冲区 1/4)的文本之后收缩缓冲区
+#ifndef LIBSERIAL_PARSE_GROW_QUIET
+#define LIBSERIAL_PARSE_GROW_QUIET			64
+#endif
+
+// 缓冲区自动增长信息
+#ifndef LIBSERIAL_PARSE_ALIGNED
+#pragma pack(1)
+#endif
+typedef struct {
+	libserial_parse_buf_t *owner;	// 所属缓冲区, 增长或收缩后同步更新其 buf 和 total
+	void *block;			// 解析器对象所在的内存块(启用增长后与文本缓冲区分离)
+	unsigned int base;		// 启用时的缓冲区大小, 收缩的下限
+	unsigned int limit;		// 缓冲区增长上限, 0 表示未启用
+	unsigned int quiet;		// 连续较短文本的个数
+}parse_grow_t;
+#pragma pack()
+#endif
+
+#ifdef LIBSERIAL_PARSE_STATS
+// 运行统计, 解析线程写入期间 seq 为奇数, 读取方据此获取一致的快照
+typedef struct {
+	atomic_uint seq;				// 更新序号
+	unsigned long long start;		// 批量接口调用开始时的周期数(仅解析线程使用)
+	libserial_parse_stats_t data;	// 统计数据
+}parse_stats_t;
+
+#define LIBSERIAL_PARSE_STATS_ALIGN		8
+#define LIBSERIAL_PARSE_STATS_SIZE		sizeof(parse_stats_t)
+#endif
+
 // 解析器对象
+#ifndef LIBSERIAL_PARSE_ALIGNED
 #pragma pack(1)
+#endif
 typedef struct {
 	parse_buffer_t buf;		// 缓冲区
 	parse_status_t sta;		// 内部状态
 	parse_config_t cfg;		// 配置信息
+#ifdef LIBSERIAL_PARSE_TOKENS
+	libserial_parse_token_arena_t *tokens;	// 挂接的文本收集区(NULL 表示未挂接)
+#endif
+#ifdef LIBSERIAL_PARSE_FILTER
+	parse_filter_t flt;		// 行过滤状态
+#endif
+#ifdef LIBSERIAL_PARSE_INTERN
+	parse_intern_t itn;		// 行驻留状态
+#endif
+#ifdef LIBSERIAL_PARSE_IDLE
+	parse_idle_t idle;		// 空闲超时状态
+#endif
+#ifdef LIBSERIAL_PARSE_GROW
+	parse_grow_t grow;		// 自动增长信息
+#endif
+#ifdef LIBSERIAL_PARSE_STATS
+	char stats[LIBSERIAL_PARSE_STATS_ALIGN - 1 + LIBSERIAL_PARSE_STATS_SIZE];	// 运行统计(使用时按 8 字节对齐)
+#endif
 }parse_object_t;
 #pragma pack()
 
+// 多通道解析器池对象, 各通道的热点状态按数组连续存放
+typedef struct {
+	parse_object_t obj;		// 当前处理通道的解析器对象(配置信息为所有通道共享)
+	unsigned int channels;	// 通道个数
+	unsigned int *idx;		// 各通道存储数据的索引
+	unsigned int *len;		// 各通道解析后的数据长度
+	char *sta;				// 各通道双引号(bit0)、截断(bit1)、转义(bit2~3)和十六进制数字(bit4~7)状态
+	char *end;				// 各通道结束上一个文本的分隔字符
+	char *text;				// 各通道文本缓冲区的起始地址, 每个通道 obj.buf.space 字节
+}parse_pool_t;
+
+// 数值语法状态
+#define LIBSERIAL_PARSE_NUM_START			0		// 等待数值
+#define LIBSERIAL_PARSE_NUM_SIGN			1		// 已读到正负号
+#define LIBSERIAL_PARSE_NUM_ZERO			2		// 已读到整数部分的第一个 0
+#define LIBSERIAL_PARSE_NUM_INT				3		// 整数部分
+#define LIBSERIAL_PARSE_NUM_DOT				4		// 已读到没有整数部分的小数点, 等待数字
+#define LIBSERIAL_PARSE_NUM_FRAC			5		// 小数部分
+#define LIBSERIAL_PARSE_NUM_EXP				6		// 已读到 e/E, 等待指数
+#define LIBSERIAL_PARSE_NUM_ESIGN			7		// 已读到指数的正负号
+#define LIBSERIAL_PARSE_NUM_EDIG			8		// 指数部分
+#define LIBSERIAL_PARSE_NUM_HEX				9		// 已读到 0x, 等待十六进制数字
+#define LIBSERIAL_PARSE_NUM_HDIG			10		// 十六进制数字
+#define LIBSERIAL_PARSE_NUM_ERROR			11		// 已出现非法字符
+
+// 可精确累加的十进制有效数字个数
+#define LIBSERIAL_PARSE_NUM_DIGITS			19
+
+// 数值转换状态, 随片段的字符逐个累加
+typedef struct {
+	unsigned char st;			// 数值语法状态
+	unsigned char neg;			// 负数
+	unsigned char eneg;			// 负指数
+	unsigned char inexact;		// 有效数字超出可精确累加的位数(十六进制为超出 64 位)
+	unsigned int digits;		// 已累加的十进制有效数字个数
+	unsigned int err;			// 第一个非法字符相对片段起始的偏移
+	int scale;					// 有效数字相对小数点的位移
+	int exp;					// 指数
+	unsigned long long mant;	// 累加的有效数字
+}parse_number_t;
+
+// 内部数据结构占用的空间(包含对齐所需的余量)
+#if defined(LIBSERIAL_PARSE_ALIGNED)
+#define LIBSERIAL_PARSE_OBJECT_SIZE			(sizeof(parse_object_t) + LIBSERIAL_PARSE_ALIGN - 1)
+#else
+#define LIBSERIAL_PARSE_OBJECT_SIZE			sizeof(parse_object_t)
+#endif
+
+// 头文件导出的编译期上限必须覆盖实际占用的空间
+typedef char parse_internal_max_check_t[(LIBSERIAL_PARSE_OBJECT_SIZE <= LIBSERIAL_PARSE_INTERNAL_MAX) ? 1 : -1];
+
+// 多通道解析器池对象的对齐字节数
+#if defined(LIBSERIAL_PARSE_ALIGNED)
+#define LIBSERIAL_PARSE_POOL_ALIGN			LIBSERIAL_PARSE_ALIGN
+#else
+#define LIBSERIAL_PARSE_POOL_ALIGN			sizeof(void *)
+#endif
+
 /*---------------------------------------------------------------------
 *	函数: 	get_parse_object
 *	功能:	从用户提供的内存中获取缓冲区描述信息的位置
@@ -56,273 +275,2807 @@ typedef struct {
 *---------------------------------------------------------------------*/
 static inline parse_object_t *get_parse_object(libserial_parse_buf_t *spbuf)
 {
+#if defined(LIBSERIAL_PARSE_ALIGNED) || defined(LIBSERIAL_PARSE_GROW)
+	return (parse_object_t *)spbuf->obj;
+#else
 	return (parse_object_t *)(spbuf->buf + spbuf->total - sizeof(parse_object_t));
+#endif
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_preprocess
-*	功能:	对数据进行预处理
-*	参数:	obj: 解析器对象		indata: 输入数据
-*	返回:	0:数据有效可以存储		1:数据可以被忽略
+*	函数: 	locate_parse_object
+*	功能:	计算解析器对象在用户提供的内存中的存放位置
+*	参数:	spbuf: 用户提供的内存
+*	返回:	解析器对象
+*	备注:	对齐布局下向下对齐到 LIBSERIAL_PARSE_ALIGN, 仍位于最后 LIBSERIAL_PARSE_OBJECT_SIZE 字节内
 *---------------------------------------------------------------------*/
-static inline int libserial_parse_preprocess(parse_object_t *obj, char indata)
+static inline parse_object_t *locate_parse_object(libserial_parse_buf_t *spbuf)
 {
-	// 移除双引号并标记好
-	if('\"' == indata){
-		obj->sta.dqu = !obj->sta.dqu;
-		return 1;
-	}
+#if defined(LIBSERIAL_PARSE_ALIGNED)
+	size_t addr = (size_t)(spbuf->buf + spbuf->total - sizeof(parse_object_t));
+	spbuf->obj = (void *)(addr & ~(size_t)(LIBSERIAL_PARSE_ALIGN - 1));
+#elif defined(LIBSERIAL_PARSE_GROW)
+	spbuf->obj = (void *)(spbuf->buf + spbuf->total - sizeof(parse_object_t));
+#endif
+	return get_parse_object(spbuf);
+}
 
-	// 如果是在双引号内的字符串则让忽略失效
-	if(!obj->sta.dqu && obj->cfg.ignore == indata){
-		return 1;
-	}
-	
-	// 移除前置空格
-	if(0 == obj->buf.idx && ' ' == indata){
-		return 1;
+#ifdef LIBSERIAL_PARSE_STATS
+// 周期计数器, 可预先定义 LIBSERIAL_PARSE_STATS_CYCLES() 替换(如 Cortex-M 的 DWT->CYCCNT)
+#ifndef LIBSERIAL_PARSE_STATS_CYCLES
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LIBSERIAL_PARSE_STATS_CYCLES()		__rdtsc()
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define LIBSERIAL_PARSE_STATS_CYCLES()		__rdtsc()
+#elif defined(__aarch64__)
+static inline unsigned long long libserial_parse_stats_cntvct(void)
+{
+	unsigned long long val;
+	__asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(val));
+	return val;
+}
+#define LIBSERIAL_PARSE_STATS_CYCLES()		libserial_parse_stats_cntvct()
+#else
+#define LIBSERIAL_PARSE_STATS_CYCLES()		0
+#endif
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	get_parse_stats
+*	功能:	获取解析器对象中按 8 字节对齐的运行统计
+*	参数:	obj: 解析器对象
+*	返回:	运行统计
+*---------------------------------------------------------------------*/
+static inline parse_stats_t *get_parse_stats(parse_object_t *obj)
+{
+	size_t addr = (size_t)obj->stats;
+	return (parse_stats_t *)((addr + LIBSERIAL_PARSE_STATS_ALIGN - 1) & ~(size_t)(LIBSERIAL_PARSE_STATS_ALIGN - 1));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_stats_bin
+*	功能:	计算数值所在的直方图区间
+*	参数:	val: 数值  bins: 区间个数
+*	返回:	区间序号(floor(log2(val)), 超出范围取最后一项)
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_stats_bin(unsigned long long val, unsigned int bins)
+{
+	unsigned int bin = 0x00;
+
+	while(val > 1 && bin < bins - 1){
+		val >>= 1;
+		bin++;
 	}
 
-	return 0;
+	return bin;
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_shift_convert
-*	功能:	对数据根据配置进行大小写转换
-*	参数:	obj: 解析器对象		indata: 输入数据
-*	返回:	被转换后的数据
-*	备注:	未启用转换功能或双引号内的字符不进行转换
+*	函数: 	libserial_parse_stats_dqu
+*	功能:	判断一段数据结束时双引号是否仍未闭合
+*	参数:	data: 输入数据  size: 数据长度
+*	返回:	0: 已闭合  1: 未闭合
+*	备注:	用于零拷贝路径, 该路径不逐字节更新双引号状态
 *---------------------------------------------------------------------*/
-static char libserial_parse_shift_convert(parse_object_t* obj, char indata)
+static inline unsigned int libserial_parse_stats_dqu(const char *data, unsigned int size)
 {
-	// 大小写数据转换(双引号内的字符不进行转换)
-	if (LIBSERIAL_PARSE_SHIFT_NORMAL != obj->cfg.shift && !obj->sta.dqu) {
-		indata = (LIBSERIAL_PARSE_SHIFT_LOWER == obj->cfg.shift) ? tolower(indata) : toupper(indata);
+	unsigned int i = 0x00, dqu = 0x00;
+
+	for(i = 0; i < size; i++){
+		dqu ^= ('\"' == data[i]);
 	}
 
-	return indata;
+	return dqu;
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_internal_size
-*	功能:	返回内部数据结构占用字节数
-*	参数:	无需参数
-*	返回:	内部数据结构占用字节数 
+*	函数: 	libserial_parse_stats_begin
+*	功能:	开始更新运行统计, 序号变为奇数
+*	参数:	obj: 解析器对象
+*	返回:	无返回值
 *---------------------------------------------------------------------*/
-unsigned int libserial_parse_internal_size()
+static inline void libserial_parse_stats_begin(parse_object_t *obj)
 {
-	return sizeof(parse_object_t);
+	parse_stats_t *st = get_parse_stats(obj);
+
+	atomic_store_explicit(&st->seq, atomic_load_explicit(&st->seq, memory_order_relaxed) + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	st->start = LIBSERIAL_PARSE_STATS_CYCLES();
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_create
-*	功能:	使用接口内部申请指定可用大小的空间(包含内部数据结构所用空间)
-*	参数:	size: 申请可用缓冲区大小 
-*	返回:	NULL: 申请内存空间失败		>0: 申请成功
+*	函数: 	libserial_parse_stats_end
+*	功能:	结束更新运行统计, 序号变为偶数
+*	参数:	obj: 解析器对象  bytes: 本次消耗的字节数  len: 本次输出的文本长度  feed: 是否为批量接口
+*	返回:	无返回值
 *---------------------------------------------------------------------*/
-libserial_parse_buf_t *libserial_parse_create(unsigned int size)
+static inline void libserial_parse_stats_end(parse_object_t *obj, unsigned int bytes, unsigned int len, int feed)
 {
-	libserial_parse_buf_t *spbuf = NULL;
-	
-	spbuf = (libserial_parse_buf_t *)malloc(sizeof(libserial_parse_buf_t));
-	if(0 == size || NULL == spbuf){
-		return NULL;
+	parse_stats_t *st = get_parse_stats(obj);
+
+	st->data.bytes += bytes;
+	if(len > 0){
+		st->data.tokens++;
+		st->data.len_hist[libserial_parse_stats_bin(len, LIBSERIAL_PARSE_STATS_LEN_BINS)]++;
 	}
-	
-	spbuf->total = size + sizeof(parse_object_t);
-	if((spbuf->buf = (char *)malloc(spbuf->total)) == NULL){
-		free(spbuf);
-		return NULL;
+	if(feed){
+		st->data.feeds++;
+		st->data.cycle_hist[libserial_parse_stats_bin(LIBSERIAL_PARSE_STATS_CYCLES() - st->start, LIBSERIAL_PARSE_STATS_CYCLE_BINS)]++;
 	}
 
-	return spbuf;
+	atomic_store_explicit(&st->seq, atomic_load_explicit(&st->seq, memory_order_relaxed) + 1, memory_order_release);
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_release
-*	功能:	释放接口内部申请的内存空间
-*	参数:	spbuf: 由 libserial_parse_create() 创建的内存空间
+*	函数: 	libserial_parse_stats_snapshot
+*	功能:	读取一致的运行统计快照
+*	参数:	obj: 解析器对象  stats: 返回运行统计
 *	返回:	无返回值
 *---------------------------------------------------------------------*/
-void libserial_parse_release(libserial_parse_buf_t *spbuf)
+static void libserial_parse_stats_snapshot(parse_object_t *obj, libserial_parse_stats_t *stats)
 {
-	if (spbuf) {
-		spbuf->total = 0;
-		free(spbuf->buf);
-		free(spbuf);
+	parse_stats_t *st = get_parse_stats(obj);
+	unsigned int seq = 0x00;
+
+	do{
+		while((seq = atomic_load_explicit(&st->seq, memory_order_acquire)) & 0x01);
+		memcpy(stats, &st->data, sizeof(*stats));
+		atomic_thread_fence(memory_order_acquire);
+	}while(seq != atomic_load_explicit(&st->seq, memory_order_relaxed));
+}
+
+#define LIBSERIAL_PARSE_STAT_ADD(obj, field, n)				(get_parse_stats(obj)->data.field += (n))
+#define LIBSERIAL_PARSE_STAT_BEGIN(obj)						libserial_parse_stats_begin(obj)
+#define LIBSERIAL_PARSE_STAT_END(obj, bytes, len, feed)		libserial_parse_stats_end(obj, bytes, len, feed)
+#else
+#define LIBSERIAL_PARSE_STAT_ADD(obj, field, n)				((void)0)
+#define LIBSERIAL_PARSE_STAT_BEGIN(obj)						((void)0)
+#define LIBSERIAL_PARSE_STAT_END(obj, bytes, len, feed)		((void)0)
+#endif
+
+#ifdef LIBSERIAL_PARSE_GROW
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_resize
+*	功能:	调整可增长缓冲区的大小, 并同步更新所属缓冲区的描述信息
+*	参数:	obj: 解析器对象	space: 新的缓冲区大小
+*	返回:	0: 内存不足  1: 调整成功
+*	备注:	缓冲区前 min(原大小, space) 字节的内容保持不变
+*---------------------------------------------------------------------*/
+static int libserial_parse_resize(parse_object_t *obj, unsigned int space)
+{
+	char *buf = (char *)realloc(obj->buf.buf, space);
+
+	if(NULL == buf){
+		return 0;
 	}
-	return ;
+
+	obj->buf.buf   = buf;
+	obj->buf.space = space;
+	obj->grow.owner->buf   = buf;
+	obj->grow.owner->total = space;
+	return 1;
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_init
-*	功能:	使用用户提供的或创建接口的缓冲区, 初始化内部数据结构
-*	参数:	spbuf: 缓冲区  size: 缓冲区大小
-*	返回:	0: 不满足最小长度要求  >0: 可存储最长文本的长度 
-*	备注:	默认设置忽略字符为: '\0', 默认设置分隔字符为: '\n'
+*	函数: 	libserial_parse_grow
+*	功能:	按倍数扩大缓冲区, 不超过增长上限
+*	参数:	obj: 解析器对象
+*	返回:	0: 未启用、已达到上限或内存不足  1: 扩大成功
 *---------------------------------------------------------------------*/
-unsigned int libserial_parse_init(libserial_parse_buf_t *spbuf)
+static int libserial_parse_grow(parse_object_t *obj)
 {
-	parse_object_t *obj = get_parse_object(spbuf);
-	
-	memset(spbuf->buf, 0x00, spbuf->total);
-	if(spbuf->total < sizeof(parse_object_t) + 1){
+	unsigned int space = obj->buf.space;
+
+	if(space >= obj->grow.limit){
 		return 0;
 	}
-	
-	obj->sta.dqu	= 0x00;
-	obj->cfg.ignore = '\0';
-	obj->cfg.divide = '\n';
-	obj->cfg.shift	= 0x00;
-	obj->buf.buf   	= spbuf->buf;
-	obj->buf.idx   	= 0x00;
-	obj->buf.len   	= 0x00;
-	obj->buf.space 	= spbuf->total - sizeof(parse_object_t);
 
-	return obj->buf.space;
+	space = (space > obj->grow.limit / 2) ? obj->grow.limit : space * 2;
+	return libserial_parse_resize(obj, space);
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_reset_buf
-*	功能:	重置解析器缓冲区
-*	参数:	spbuf: 缓冲区
+*	函数: 	libserial_parse_grow_begin
+*	功能:	解析接口调用开始时, 在两个文本之间逐步收缩长期未被充分使用的缓冲区
+*	参数:	obj: 解析器对象
 *	返回:	无返回值
-*	备注:	不影响 libserial_parse_set_divide()\libserial_parse_set_ignore()
+*	备注:	上一个文本较短, 收缩一半后仍完整保留在缓冲区内
 *---------------------------------------------------------------------*/
-void libserial_parse_reset_buf(libserial_parse_buf_t *spbuf)
+static inline void libserial_parse_grow_begin(parse_object_t *obj)
 {
-	parse_object_t *obj = get_parse_object(spbuf);
-	obj->sta.dqu 	= 0x00;
-	obj->buf.idx	= 0x00;
-	obj->buf.len	= 0x00;
-	obj->buf.buf[0] = '\0';
+	unsigned int space = obj->buf.space / 2;
+
+	if(obj->grow.quiet >= LIBSERIAL_PARSE_GROW_QUIET && 0 == obj->buf.idx){
+		obj->grow.quiet = 0x00;
+		libserial_parse_resize(obj, (space > obj->grow.base) ? space : obj->grow.base);
+	}
 	return ;
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_set_divide
-*	功能:	设定分隔字符
-*	参数:	splbuf: 缓冲区  divide: 分隔字符
+*	函数: 	libserial_parse_grow_end
+*	功能:	解析接口调用结束时, 统计缓冲区扩大后连续较短文本的个数
+*	参数:	obj: 解析器对象  len: 本次输出的文本长度
 *	返回:	无返回值
 *---------------------------------------------------------------------*/
-void libserial_parse_set_divide(libserial_parse_buf_t *spbuf, char divide)
+static inline void libserial_parse_grow_end(parse_object_t *obj, unsigned int len)
 {
-	parse_object_t *obj = get_parse_object(spbuf);
-	obj->cfg.divide = divide;
+	if(len > 0 && obj->grow.limit && obj->buf.space > obj->grow.base){
+		obj->grow.quiet = (len < obj->buf.space / 4) ? obj->grow.quiet + 1 : 0;
+	}
+	return ;
 }
 
+#define LIBSERIAL_PARSE_GROWABLE(obj)						(0 != (obj)->grow.limit)
+#define LIBSERIAL_PARSE_GROW_BEGIN(obj)						libserial_parse_grow_begin(obj)
+#define LIBSERIAL_PARSE_GROW_END(obj, len)					libserial_parse_grow_end(obj, len)
+#else
+#define LIBSERIAL_PARSE_GROWABLE(obj)						0
+#define LIBSERIAL_PARSE_GROW_BEGIN(obj)						((void)(obj))
+#define LIBSERIAL_PARSE_GROW_END(obj, len)					((void)(obj), (void)(len))
+#endif
+
+#ifdef LIBSERIAL_PARSE_TOKENS
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_set_ignore
-*	功能:	设定忽略字符, 传入 '\0' 代表不忽略任何字符
-*	参数:	splbuf: 缓冲区  ignore: 忽略字符
+*	函数: 	libserial_parse_tokens_begin
+*	功能:	将缓冲区定位到文本收集区的空闲位置
+*	参数:	obj: 解析器对象
 *	返回:	无返回值
-*	备注:	双引号内的字符不会受此限制
+*	备注:	收集区被重置后, 未完成的文本随之移到新的位置
 *---------------------------------------------------------------------*/
-void libserial_parse_set_ignore(libserial_parse_buf_t *spbuf, char ignore)
+static inline void libserial_parse_tokens_begin(parse_object_t *obj)
 {
-	parse_object_t *obj = get_parse_object(spbuf);
-	obj->cfg.ignore = ignore;
+	libserial_parse_token_arena_t *arena = obj->tokens;
+	char *buf = arena->buf + arena->used;
+
+	if(buf != obj->buf.buf){
+		memmove(buf, obj->buf.buf, obj->buf.idx);
+		buf[obj->buf.idx] = '\0';
+		obj->buf.buf   = buf;
+		obj->buf.space = arena->total - arena->used;
+	}
+	return ;
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_set_shift
-*	功能:	设置大小写字母转换
-*	参数:	splbuf: 缓冲区  shift: 0:不做转换 1:转换为小写字母 2:转换为大写字母
+*	函数: 	libserial_parse_tokens_end
+*	功能:	将刚解析完成的文本保留在文本收集区内
+*	参数:	obj: 解析器对象  len: 文本长度
 *	返回:	无返回值
+*	备注:	文本已位于收集区的空闲位置, 只需记录片段并移动已使用的位置;
+*			收集后至少保留 2 字节空闲空间, 保证缓冲区仍可解析
 *---------------------------------------------------------------------*/
-void libserial_parse_set_shift(libserial_parse_buf_t *spbuf, char shift)
+static inline void libserial_parse_tokens_end(parse_object_t *obj, unsigned int len)
 {
-	parse_object_t *obj = get_parse_object(spbuf);
-	obj->cfg.shift = shift;
+	libserial_parse_token_arena_t *arena = obj->tokens;
+	unsigned int off = (unsigned int)(obj->buf.buf - arena->buf);
+
+	if(arena->count >= arena->argc || arena->total - off - len - 1 < 2){
+		arena->dropped++;
+		return ;
+	}
+
+	arena->argv[arena->count].off	 = off;
+	arena->argv[arena->count].len	 = len;
+	arena->argv[arena->count].divide = obj->sta.end;
+	arena->count++;
+	arena->used = off + len + 1;
+	return ;
 }
 
+#define LIBSERIAL_PARSE_COLLECTING(obj)						(NULL != (obj)->tokens)
+#define LIBSERIAL_PARSE_TOKENS_BEGIN(obj)					do{ if((obj)->tokens) libserial_parse_tokens_begin(obj); }while(0)
+#define LIBSERIAL_PARSE_TOKENS_END(obj, len)				do{ if((len) > 0 && (obj)->tokens) libserial_parse_tokens_end(obj, len); }while(0)
+#else
+#define LIBSERIAL_PARSE_COLLECTING(obj)						0
+#define LIBSERIAL_PARSE_TOKENS_BEGIN(obj)					((void)(obj))
+#define LIBSERIAL_PARSE_TOKENS_END(obj, len)				((void)(obj), (void)(len))
+#endif
+
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_text
-*	功能:	解析以指定符号分隔或跳过的文本
-*	参数:	splbuf: 缓冲区  indata: 输入数据
-*	返回:	0: 正在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
-*	备注:	没有设定分隔符则会一直返回0, 数据超出缓存长度会返回解析完成
+*	函数: 	libserial_parse_call_begin
+*	功能:	解析接口调用开始时的处理(记录收到数据的时间、缓冲区收缩、定位到文本收集区)
+*	参数:	obj: 解析器对象
+*	返回:	无返回值
 *---------------------------------------------------------------------*/
-unsigned int libserial_parse_text(libserial_parse_buf_t *spbuf, char indata)
+static inline void libserial_parse_call_begin(parse_object_t *obj)
 {
-	parse_object_t *obj = get_parse_object(spbuf);
-
-	// 对数据进行预处理
-	if(libserial_parse_preprocess(obj, indata) == 1){
-		return 0;
-	}
-	
-	// 匹配分隔符
-	if(obj->cfg.divide == indata){
-		obj->buf.len = obj->buf.idx;
-		obj->buf.idx = 0;
-		obj->sta.dqu = 0;
-		return obj->buf.len;
+#ifdef LIBSERIAL_PARSE_IDLE
+	// 未挂接时钟回调时只做标记, 由其后第一次 libserial_parse_poll() 记录时间
+	if(obj->idle.clock){
+		obj->idle.last   = obj->idle.clock(obj->idle.ctx);
+		obj->idle.active = 0x00;
+	}else{
+		obj->idle.active = 1;
 	}
+#endif
+	LIBSERIAL_PARSE_GROW_BEGIN(obj);
+	LIBSERIAL_PARSE_TOKENS_BEGIN(obj);
+	return ;
+}
 
-	// 大小写转换检查
-	indata = libserial_parse_shift_convert(obj, indata);
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_call_end
+*	功能:	解析接口调用结束时的处理(缓冲区使用统计、收集文本)
+*	参数:	obj: 解析器对象  len: 本次输出的文本长度
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_call_end(parse_object_t *obj, unsigned int len)
+{
+	LIBSERIAL_PARSE_GROW_END(obj, len);
+	LIBSERIAL_PARSE_TOKENS_END(obj, len);
+	return ;
+}
 
-	// 复制数据
-	if(obj->buf.idx < obj->buf.space - 1){
-		obj->buf.buf[obj->buf.idx+1] = '\0';
-		obj->buf.buf[obj->buf.idx++] = indata;
-		obj->buf.len = obj->buf.idx;
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_preprocess
+*	功能:	对数据进行预处理
+*	参数:	obj: 解析器对象		indata: 输入数据
+*	返回:	0:数据有效可以存储		1:数据可以被忽略
+*---------------------------------------------------------------------*/
+static inline int libserial_parse_preprocess(parse_object_t *obj, char indata)
+{
+	// 移除双引号并标记好
+	if('\"' == indata){
+		obj->sta.dqu = !obj->sta.dqu;
+		return 1;
 	}
-	
-	// 长度检查
-	if(obj->buf.idx >= obj->buf.space - 1){
-		obj->buf.idx = 0;
-		obj->sta.dqu = 0;
-		return obj->buf.len;
+
+	// 如果是在双引号内的字符串则让忽略失效
+	if(!obj->sta.dqu && LIBSERIAL_PARSE_MAP_TEST(obj->cfg.ignore, indata)){
+		return 1;
 	}
 	
+	// 移除前置空格
+	if(0 == obj->buf.idx && ' ' == indata){
+		return 1;
+	}
+
 	return 0;
 }
 
 /*---------------------------------------------------------------------
-*	函数: 	libserial_parse_text_nl  (nl -> new line)
-*	功能:	解析以换行符为终止符的文本(支持 '\n' 和 '\r\n')
-*	参数:	splbuf: 缓冲区  indata: 输入数据
-*	返回:	0: 正在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
-*	备注:	不受 libserial_parse_set_divide()\libserial_parse_set_ignore() 影响
+*	函数: 	libserial_parse_shift_convert
+*	功能:	对数据根据配置进行大小写转换
+*	参数:	obj: 解析器对象		indata: 输入数据
+*	返回:	被转换后的数据
+*	备注:	未启用转换功能时使用恒等表, 双引号内的字符不进行转换
 *---------------------------------------------------------------------*/
-unsigned int libserial_parse_text_nl(libserial_parse_buf_t *spbuf, char indata)
+static inline char libserial_parse_shift_convert(parse_object_t* obj, char indata)
 {
-	parse_object_t *obj = get_parse_object(spbuf);
+	// 查表转换(双引号内的字符不进行转换)
+	char conv = (char)obj->cfg.table[(unsigned char)indata];
+	return obj->sta.dqu ? indata : conv;
+}
 
-	// 检查换行字符
-	if('\n' == indata)
-	{
-		if(obj->buf.idx && '\r' == obj->buf.buf[obj->buf.idx-1]){
-			obj->buf.idx--;
-			obj->buf.buf[obj->buf.idx] = '\0';
-		}
-		obj->buf.len = obj->buf.idx;
-		obj->buf.idx = 0;
-		obj->sta.dqu = 0;
-		return obj->buf.len;
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_ctz
+*	功能:	计算非零整数末尾 0 的位数
+*	参数:	mask: 非零整数
+*	返回:	末尾 0 的位数
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_ctz(unsigned long long mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (unsigned int)__builtin_ctzll(mask);
+#else
+	unsigned int n = 0x00;
+	while(0 == (mask & 0x01)){
+		mask >>= 1;
+		n++;
 	}
+	return n;
+#endif
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_scan
+*	功能:	查找数据中第一个属于指定字符集合的字符
+*	参数:	data: 输入数据	size: 数据长度	set: 需要查找的字符	cnt: 字符个数(1~LIBSERIAL_PARSE_SCAN_MAX)
+*	返回:	第一个匹配字符的偏移, 没有匹配则返回 size
+*	备注:	根据编译目标选择 AVX2/SSE2/NEON 向量指令或 SWAR 实现
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_scan(const char *data, unsigned int size, const char *set, unsigned int cnt)
+{
+	unsigned int i = 0x00, k = 0x00;
+
+#if defined(LIBSERIAL_PARSE_SCAN_AVX2)
+	__m256i vs[LIBSERIAL_PARSE_SCAN_MAX];
+	for(k = 0; k < cnt; k++){
+		vs[k] = _mm256_set1_epi8(set[k]);
+	}
+	for(; i + 32 <= size; i += 32){
+		__m256i v = _mm256_loadu_si256((const __m256i *)(data + i));
+		__m256i m = _mm256_cmpeq_epi8(v, vs[0]);
+		for(k = 1; k < cnt; k++){
+			m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, vs[k]));
+		}
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(m);
+		if(mask){
+			return i + libserial_parse_ctz(mask);
+		}
+	}
+#elif defined(LIBSERIAL_PARSE_SCAN_SSE2)
+	__m128i vs[LIBSERIAL_PARSE_SCAN_MAX];
+	for(k = 0; k < cnt; k++){
+		vs[k] = _mm_set1_epi8(set[k]);
+	}
+	for(; i + 16 <= size; i += 16){
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+		__m128i m = _mm_cmpeq_epi8(v, vs[0]);
+		for(k = 1; k < cnt; k++){
+			m = _mm_or_si128(m, _mm_cmpeq_epi8(v, vs[k]));
+		}
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(m);
+		if(mask){
+			return i + libserial_parse_ctz(mask);
+		}
+	}
+#elif defined(LIBSERIAL_PARSE_SCAN_NEON)
+	uint8x16_t vs[LIBSERIAL_PARSE_SCAN_MAX];
+	for(k = 0; k < cnt; k++){
+		vs[k] = vdupq_n_u8((uint8_t)set[k]);
+	}
+	for(; i + 16 <= size; i += 16){
+		uint8x16_t v = vld1q_u8((const uint8_t *)(data + i));
+		uint8x16_t m = vceqq_u8(v, vs[0]);
+		for(k = 1; k < cnt; k++){
+			m = vorrq_u8(m, vceqq_u8(v, vs[k]));
+		}
+		// 每个字节压缩为 4 位掩码
+		uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+		if(mask){
+			return i + (libserial_parse_ctz(mask) >> 2);
+		}
+	}
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	// SWAR: 一次比较 8 个字节, 最低位的命中字节一定是准确的
+	const unsigned long long ones = 0x0101010101010101ULL, high = 0x8080808080808080ULL;
+	unsigned long long vs[LIBSERIAL_PARSE_SCAN_MAX];
+	for(k = 0; k < cnt; k++){
+		vs[k] = ones * (unsigned char)set[k];
+	}
+	for(; i + 8 <= size; i += 8){
+		unsigned long long v = 0x00, x = 0x00, mask = 0x00;
+		memcpy(&v, data + i, sizeof(v));
+		for(k = 0; k < cnt; k++){
+			x = v ^ vs[k];
+			mask |= (x - ones) & ~x;
+		}
+		if(mask & high){
+			return i + (libserial_parse_ctz(mask & high) >> 3);
+		}
+	}
+#endif
+
+	for(; i < size; i++){
+		for(k = 0; k < cnt; k++){
+			if(set[k] == data[i]){
+				return i;
+			}
+		}
+	}
+
+	return size;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_scan_stop
+*	功能:	查找数据中第一个双引号、启用转义时的反斜杠、忽略字符或分隔字符
+*	参数:	obj: 解析器对象		data: 输入数据	size: 数据长度
+*	返回:	第一个特殊字符的偏移, 没有则返回 size
+*	备注:	字符集合过大时退化为逐字节查位图
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_scan_stop(parse_object_t *obj, const char *data, unsigned int size)
+{
+	unsigned int i = 0x00;
+
+	if(obj->cfg.nstop <= LIBSERIAL_PARSE_SCAN_MAX){
+		return libserial_parse_scan(data, size, obj->cfg.stop, obj->cfg.nstop);
+	}
+
+	for(i = 0; i < size; i++){
+		if('\"' == data[i] || ('\\' == data[i] && obj->cfg.escape) || LIBSERIAL_PARSE_MAP_TEST(obj->cfg.divide, data[i]) || LIBSERIAL_PARSE_MAP_TEST(obj->cfg.ignore, data[i])){
+			break;
+		}
+	}
+
+	return i;
+}
+
+#ifdef LIBSERIAL_PARSE_FILTER
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_scan
+*	功能:	运行行过滤自动机, 直至匹配到关键字、遇到换行符或数据结束
+*	参数:	obj: 解析器对象  data: 输入数据  size: 数据长度  pos: data 之前当前文本已有的字节数
+*	返回:	已处理的字节数(不包含换行符), 匹配时以匹配到的字符结束并设置 obj->flt.hit
+*	备注:	处于初始状态且不在文本开头时, 批量跳过不可能开始行内关键字的字符
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_filter_scan(parse_object_t *obj, const char *data, unsigned int size, unsigned int pos)
+{
+	const libserial_parse_filter_t *filter = obj->flt.filter;
+	const unsigned int *next = filter->next;
+	const unsigned char *cls = filter->cls;
+	unsigned int i = 0x00, s = obj->flt.state, t = 0x00, out = 0x00, id = 0x00;
+
+	while(i < size && '\n' != data[i]){
+		if(filter->nskip > 0 && 0 == s && pos + i > 0){
+			i += libserial_parse_scan(data + i, size - i, filter->skip, filter->nskip);
+			if(i >= size || '\n' == data[i]){
+				break;
+			}
+		}
+
+		s = next[s + cls[(unsigned char)data[i++]]];
+		if(s < filter->match){
+			continue;
+		}
+
+		// 行首关键字只在当前文本整体都是关键字前缀时有效
+		t   = s / filter->classes;
+		out = filter->out[t];
+		id  = out & 0xFFFF;
+		if((out >> 16) && filter->depth[t] == pos + i && (0 == id || (out >> 16) < id)){
+			id = out >> 16;
+		}
+		if(id){
+			obj->flt.hit = (unsigned short)id;
+			break;
+		}
+	}
+
+	obj->flt.state = s;
+	return i;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_end
+*	功能:	文本结束时的行过滤处理
+*	参数:	obj: 解析器对象  len: 文本长度
+*	返回:	匹配时返回文本长度, 否则丢弃文本并返回 0
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_filter_end(parse_object_t *obj, unsigned int len)
+{
+	obj->flt.state = 0x00;
+	if(obj->flt.hit){
+		obj->flt.last = obj->flt.hit;
+		obj->flt.hit  = 0x00;
+		return len;
+	}
+
+	LIBSERIAL_PARSE_STAT_ADD(obj, filtered, len > 0);
+	obj->buf.len = 0x00;
+	obj->buf.buf[0] = '\0';
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_skip
+*	功能:	丢弃未匹配任何关键字的文本, 结束状态和运行统计与逐字节解析一致
+*	参数:	obj: 解析器对象  data: 文本在本数据块内未拷贝的部分  size: 该部分长度  
+*			end: 结束文本的字符('\n' 或缓冲区已满时为 '\0')
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_filter_skip(parse_object_t *obj, const char *data, unsigned int size, char end)
+{
+	unsigned int len = obj->buf.idx + size;
+	char last = (size > 0) ? data[size - 1] : (len > 0) ? obj->buf.buf[len - 1] : 0x00;
+
+	if('\n' == end && '\r' == last){
+		len--;
+	}
+	LIBSERIAL_PARSE_STAT_ADD(obj, overflows, '\0' == end);
+	LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, (0 != obj->sta.dqu) ^ libserial_parse_stats_dqu(data, size));
+	obj->sta.end = end;
+	obj->sta.ovf = ('\0' == end);
+	obj->sta.dqu = 0;
+	obj->buf.idx = 0;
+	libserial_parse_filter_end(obj, len);
+	return ;
+}
+
+#define LIBSERIAL_PARSE_FILTERING(obj)						(NULL != (obj)->flt.filter)
+#else
+#define LIBSERIAL_PARSE_FILTERING(obj)						0
+#endif
+
+#ifdef LIBSERIAL_PARSE_INTERN
+// 行驻留缓存使用的 FNV-1a 哈希
+#define LIBSERIAL_PARSE_INTERN_SEED			2166136261u
+#define LIBSERIAL_PARSE_INTERN_MIX(h, ch)	(((h) ^ (unsigned char)(ch)) * 16777619u)
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_intern_end
+*	功能:	结束文本的哈希计算并在驻留缓存中查找, 未找到时驻留到所在组最久未使用的槽位
+*	参数:	obj: 解析器对象  ptr: 文本  len: 文本长度
+*			pos: 已计入哈希的字节数  hash: 前 pos 字节的哈希值
+*	返回:	无返回值
+*	备注:	截断的文本和超出槽位长度的文本不驻留, 驻留编号为 -1
+*---------------------------------------------------------------------*/
+static void libserial_parse_intern_end(parse_object_t *obj, const char *ptr, unsigned int len, unsigned int pos, unsigned int hash)
+{
+	libserial_parse_intern_t *cache = obj->itn.cache;
+	libserial_parse_intern_slot_t *slot = NULL;
+	unsigned int i = 0x00, set = 0x00, victim = 0x00;
+
+	obj->itn.hash = LIBSERIAL_PARSE_INTERN_SEED;
+	obj->itn.pos  = 0x00;
+	obj->itn.id   = -1;
+	obj->itn.seen = 0x00;
+	if(obj->sta.ovf || len > cache->width){
+		return ;
+	}
+
+	for(i = pos; i < len; i++){
+		hash = LIBSERIAL_PARSE_INTERN_MIX(hash, ptr[i]);
+	}
+
+	// 组内依次比较哈希值、长度和内容, 同时找出空槽位或最久未使用的槽位
+	set  = ((hash ^ (hash >> 15)) & cache->mask) * LIBSERIAL_PARSE_INTERN_WAYS;
+	slot = cache->slot + set;
+	cache->clock++;
+	for(i = 0; i < LIBSERIAL_PARSE_INTERN_WAYS; i++){
+		if(slot[i].hash == hash && slot[i].len == len + 1 && 0 == memcmp(cache->text + (size_t)(set + i) * cache->width, ptr, len)){
+			slot[i].stamp = cache->clock;
+			cache->hits++;
+			obj->itn.id   = (int)(set + i);
+			obj->itn.seen = 1;
+			return ;
+		}
+		if(slot[victim].len && (0 == slot[i].len || cache->clock - slot[i].stamp > cache->clock - slot[victim].stamp)){
+			victim = i;
+		}
+	}
+
+	cache->misses++;
+	cache->evictions += (0 != slot[victim].len);
+	memcpy(cache->text + (size_t)(set + victim) * cache->width, ptr, len);
+	slot[victim].hash  = hash;
+	slot[victim].len   = len + 1;
+	slot[victim].stamp = cache->clock;
+	obj->itn.id = (int)(set + victim);
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_intern_byte
+*	功能:	逐字节解析时随拷贝计算哈希值, 文本结束时在驻留缓存中查找
+*	参数:	obj: 解析器对象  len: 本次输出的文本长度
+*	返回:	无返回值
+*	备注:	最后一个字节暂不计入, 行尾 '\r' 被移除时无需回退; 
+*			缓冲区被其他接口改写过(已计入的字节数不小于缓冲区数据长度)时从头计算
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_intern_byte(parse_object_t *obj, unsigned int len)
+{
+	parse_intern_t *itn = &obj->itn;
+
+	if(len > 0){
+		libserial_parse_intern_end(obj, obj->buf.buf, len, itn->pos, itn->hash);
+		return ;
+	}
+
+	if(itn->pos >= obj->buf.idx){
+		itn->pos  = 0x00;
+		itn->hash = LIBSERIAL_PARSE_INTERN_SEED;
+	}
+	while(itn->pos + 1 < obj->buf.idx){
+		itn->hash = LIBSERIAL_PARSE_INTERN_MIX(itn->hash, obj->buf.buf[itn->pos]);
+		itn->pos++;
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_intern_block
+*	功能:	批量接口结束时对返回的文本计算哈希值并在驻留缓存中查找
+*	参数:	obj: 解析器对象  ptr: 文本  len: 文本长度
+*	返回:	无返回值
+*	备注:	批量接口可能已结束并丢弃缓冲区中的文本, 逐字节解析的哈希值随之从头计算
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_intern_block(parse_object_t *obj, const char *ptr, unsigned int len)
+{
+	if(len > 0){
+		libserial_parse_intern_end(obj, ptr, len, 0, LIBSERIAL_PARSE_INTERN_SEED);
+		return ;
+	}
+	obj->itn.pos  = 0x00;
+	obj->itn.hash = LIBSERIAL_PARSE_INTERN_SEED;
+	return ;
+}
+
+#define LIBSERIAL_PARSE_INTERN_BYTE(obj, len)				do{ if((obj)->itn.cache) libserial_parse_intern_byte(obj, len); }while(0)
+#define LIBSERIAL_PARSE_INTERN_BLOCK(obj, ptr, len)			do{ if((obj)->itn.cache) libserial_parse_intern_block(obj, ptr, len); }while(0)
+#else
+#define LIBSERIAL_PARSE_INTERN_BYTE(obj, len)				((void)0)
+#define LIBSERIAL_PARSE_INTERN_BLOCK(obj, ptr, len)			((void)0)
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_fold
+*	功能:	批量转换 ASCII 字母大小写
+*	参数:	dst: 输出位置  src: 输入数据  size: 数据长度  lo: 需要转换的字母范围起点('A' 或 'a')
+*	返回:	已转换的字节数(向量宽度的整数倍), 剩余数据由调用者查表处理
+*	备注:	dst 可与 src 重叠, 但不得位于 src 之后
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_fold(char *dst, const char *src, unsigned int size, char lo)
+{
+	unsigned int i = 0x00;
+
+#if defined(LIBSERIAL_PARSE_SCAN_AVX2)
+	// 将 [lo, lo+25] 平移到有符号数的最小区间后一次比较
+	const __m256i off = _mm256_set1_epi8((char)(0x80 - lo)), lim = _mm256_set1_epi8(-128 + 26), bit = _mm256_set1_epi8(0x20);
+	for(; i + 32 <= size; i += 32){
+		__m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+		__m256i m = _mm256_cmpgt_epi8(lim, _mm256_add_epi8(v, off));
+		_mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(v, _mm256_and_si256(m, bit)));
+	}
+#elif defined(LIBSERIAL_PARSE_SCAN_SSE2)
+	const __m128i off = _mm_set1_epi8((char)(0x80 - lo)), lim = _mm_set1_epi8(-128 + 26), bit = _mm_set1_epi8(0x20);
+	for(; i + 16 <= size; i += 16){
+		__m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i m = _mm_cmpgt_epi8(lim, _mm_add_epi8(v, off));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(v, _mm_and_si128(m, bit)));
+	}
+#elif defined(LIBSERIAL_PARSE_SCAN_NEON)
+	const uint8x16_t off = vdupq_n_u8((uint8_t)lo), lim = vdupq_n_u8(26), bit = vdupq_n_u8(0x20);
+	for(; i + 16 <= size; i += 16){
+		uint8x16_t v = vld1q_u8((const uint8_t *)(src + i));
+		uint8x16_t m = vcltq_u8(vsubq_u8(v, off), lim);
+		vst1q_u8((uint8_t *)(dst + i), veorq_u8(v, vandq_u8(m, bit)));
+	}
+#else
+	// SWAR: 一次转换 8 个字节, 各字节的低 7 位相加不会向相邻字节进位
+	const unsigned long long ones = 0x0101010101010101ULL, high = 0x8080808080808080ULL;
+	const unsigned long long ge = ones * (unsigned char)(0x80 - lo), gt = ones * (unsigned char)(0x7f - (lo + 25));
+	for(; i + 8 <= size; i += 8){
+		unsigned long long v = 0x00, h = 0x00, m = 0x00;
+		memcpy(&v, src + i, sizeof(v));
+		h = v & ~high;
+		m = ((h + ge) ^ (h + gt)) & ~v & high;
+		v ^= m >> 2;
+		memcpy(dst + i, &v, sizeof(v));
+	}
+#endif
+
+	return i;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_translate
+*	功能:	按解析器的转换配置批量转换数据
+*	参数:	obj: 解析器对象  dst: 输出位置  src: 输入数据  size: 数据长度
+*	返回:	无返回值
+*	备注:	大小写转换使用向量指令, 用户转换表逐字节查表; dst 可与 src 重叠, 但不得位于 src 之后
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_translate(parse_object_t *obj, char *dst, const char *src, unsigned int size)
+{
+	const unsigned char *table = obj->cfg.table;
+	unsigned int i = 0x00;
+
+	if(LIBSERIAL_PARSE_SHIFT_LOWER == obj->cfg.shift){
+		i = libserial_parse_fold(dst, src, size, 'A');
+	}else if(LIBSERIAL_PARSE_SHIFT_UPPER == obj->cfg.shift){
+		i = libserial_parse_fold(dst, src, size, 'a');
+	}
+
+	for(; i < size; i++){
+		dst[i] = (char)table[(unsigned char)src[i]];
+	}
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_update_stop
+*	功能:	根据分隔字符和忽略字符集合重新生成批量扫描的停止字符
+*	参数:	obj: 解析器对象
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_update_stop(parse_object_t *obj)
+{
+	unsigned int ch = 0x00;
+
+	obj->cfg.nstop = 0x00;
+	obj->cfg.stop[obj->cfg.nstop++] = '\"';
+	if(obj->cfg.escape){
+		obj->cfg.stop[obj->cfg.nstop++] = '\\';
+	}
+	for(ch = 0; ch < 256; ch++){
+		if('\"' == ch || ('\\' == ch && obj->cfg.escape) || (!LIBSERIAL_PARSE_MAP_TEST(obj->cfg.divide, ch) && !LIBSERIAL_PARSE_MAP_TEST(obj->cfg.ignore, ch))){
+			continue;
+		}
+		if(obj->cfg.nstop >= LIBSERIAL_PARSE_SCAN_MAX){
+			obj->cfg.nstop = LIBSERIAL_PARSE_SCAN_MAX + 1;
+			return ;
+		}
+		obj->cfg.stop[obj->cfg.nstop++] = (char)ch;
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_make_map
+*	功能:	将字符串中的所有字符生成字符集合位图
+*	参数:	map: 位图	set: 字符集合字符串(NULL 或 "" 代表空集合)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_make_map(unsigned char *map, const char *set)
+{
+	memset(map, 0x00, 32);
+	for(; set && *set; set++){
+		LIBSERIAL_PARSE_MAP_SET(map, *set);
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_object_init
+*	功能:	以默认配置初始化解析器对象
+*	参数:	obj: 已清零的解析器对象	buf: 文本缓冲区	space: 文本缓冲区大小
+*	返回:	无返回值
+*	备注:	默认设置忽略字符为: '\0', 默认设置分隔字符为: '\n'
+*---------------------------------------------------------------------*/
+static void libserial_parse_object_init(parse_object_t *obj, char *buf, unsigned int space)
+{
+	obj->sta.dqu	= 0x00;
+	obj->sta.ovf	= 0x00;
+	obj->sta.full	= 0x00;
+	obj->sta.esc	= LIBSERIAL_PARSE_ESC_NONE;
+	obj->sta.end	= 0x00;
+	obj->cfg.shift	= 0x00;
+	obj->cfg.escape	= 0x00;
+#ifdef LIBSERIAL_PARSE_TOKENS
+	obj->tokens		= NULL;
+#endif
+#ifdef LIBSERIAL_PARSE_FILTER
+	obj->flt.filter	= NULL;
+#endif
+#ifdef LIBSERIAL_PARSE_INTERN
+	obj->itn.cache	= NULL;
+	obj->itn.id		= -1;
+	obj->itn.seen	= 0x00;
+#endif
+#ifdef LIBSERIAL_PARSE_IDLE
+	obj->idle.clock   = NULL;
+	obj->idle.ctx     = NULL;
+	obj->idle.timeout = 0x00;
+	obj->idle.active  = 0x00;
+#endif
+	obj->cfg.table	= libserial_parse_same_table;
+	LIBSERIAL_PARSE_MAP_SET(obj->cfg.ignore, '\0');
+	LIBSERIAL_PARSE_MAP_SET(obj->cfg.divide, '\n');
+	libserial_parse_update_stop(obj);
+	obj->buf.buf   	= buf;
+	obj->buf.idx   	= 0x00;
+	obj->buf.len   	= 0x00;
+	obj->buf.space 	= space;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_internal_size
+*	功能:	返回内部数据结构占用字节数
+*	参数:	无需参数
+*	返回:	内部数据结构占用字节数 
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_internal_size()
+{
+	return LIBSERIAL_PARSE_OBJECT_SIZE;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_create
+*	功能:	使用接口内部申请指定可用大小的空间(包含内部数据结构所用空间)
+*	参数:	size: 申请可用缓冲区大小 
+*	返回:	NULL: 申请内存空间失败		>0: 申请成功
+*---------------------------------------------------------------------*/
+libserial_parse_buf_t *libserial_parse_create(unsigned int size)
+{
+	libserial_parse_buf_t *spbuf = NULL;
+	
+	spbuf = (libserial_parse_buf_t *)malloc(sizeof(libserial_parse_buf_t));
+	if(0 == size || NULL == spbuf){
+		return NULL;
+	}
+	
+	spbuf->total = size + LIBSERIAL_PARSE_OBJECT_SIZE;
+	if((spbuf->buf = (char *)malloc(spbuf->total)) == NULL){
+		free(spbuf);
+		return NULL;
+	}
+#if defined(LIBSERIAL_PARSE_ALIGNED) || defined(LIBSERIAL_PARSE_GROW)
+	spbuf->obj = NULL;
+#endif
+
+	return spbuf;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_release
+*	功能:	释放接口内部申请的内存空间
+*	参数:	spbuf: 由 libserial_parse_create() 创建的内存空间
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_release(libserial_parse_buf_t *spbuf)
+{
+	if (spbuf) {
+#ifdef LIBSERIAL_PARSE_GROW
+		// 启用自动增长后解析器对象位于单独的内存块
+		if(spbuf->obj && LIBSERIAL_PARSE_GROWABLE(get_parse_object(spbuf))){
+			free(get_parse_object(spbuf)->grow.block);
+		}
+#endif
+		spbuf->total = 0;
+		free(spbuf->buf);
+		free(spbuf);
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_init
+*	功能:	使用用户提供的或创建接口的缓冲区, 初始化内部数据结构
+*	参数:	spbuf: 缓冲区  size: 缓冲区大小
+*	返回:	0: 不满足最小长度要求  >0: 可存储最长文本的长度 
+*	备注:	默认设置忽略字符为: '\0', 默认设置分隔字符为: '\n'
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_init(libserial_parse_buf_t *spbuf)
+{
+	parse_object_t *obj = NULL;
+	
+	memset(spbuf->buf, 0x00, spbuf->total);
+	if(spbuf->total < LIBSERIAL_PARSE_OBJECT_SIZE + 1){
+		return 0;
+	}
+	
+	obj = locate_parse_object(spbuf);
+	libserial_parse_object_init(obj, spbuf->buf, spbuf->total - LIBSERIAL_PARSE_OBJECT_SIZE);
+	return obj->buf.space;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_reset_buf
+*	功能:	重置解析器缓冲区
+*	参数:	spbuf: 缓冲区
+*	返回:	无返回值
+*	备注:	不影响 libserial_parse_set_divide()\libserial_parse_set_ignore()
+*---------------------------------------------------------------------*/
+void libserial_parse_reset_buf(libserial_parse_buf_t *spbuf)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+	LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, 0 != obj->sta.dqu);
+	obj->sta.dqu 	= 0x00;
+	obj->sta.ovf	= 0x00;
+	obj->sta.full	= 0x00;
+	obj->sta.esc	= LIBSERIAL_PARSE_ESC_NONE;
+	obj->sta.end	= 0x00;
+	obj->buf.idx	= 0x00;
+	obj->buf.len	= 0x00;
+#ifdef LIBSERIAL_PARSE_FILTER
+	obj->flt.state	= 0x00;
+	obj->flt.hit	= 0x00;
+#endif
+#ifdef LIBSERIAL_PARSE_INTERN
+	obj->itn.pos	= 0x00;
+	obj->itn.hash	= LIBSERIAL_PARSE_INTERN_SEED;
+#endif
+#ifdef LIBSERIAL_PARSE_GROW
+	// 可增长的缓冲区直接收缩回启用时的大小
+	if(LIBSERIAL_PARSE_GROWABLE(obj) && obj->buf.space > obj->grow.base){
+		obj->grow.quiet = 0x00;
+		libserial_parse_resize(obj, obj->grow.base);
+	}
+#endif
+	obj->buf.buf[0] = '\0';
+	LIBSERIAL_PARSE_STAT_END(obj, 0, 0, 0);
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_divide
+*	功能:	设定分隔字符
+*	参数:	splbuf: 缓冲区  divide: 分隔字符
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_divide(libserial_parse_buf_t *spbuf, char divide)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	memset(obj->cfg.divide, 0x00, sizeof(obj->cfg.divide));
+	LIBSERIAL_PARSE_MAP_SET(obj->cfg.divide, divide);
+	libserial_parse_update_stop(obj);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_ignore
+*	功能:	设定忽略字符, 传入 '\0' 代表不忽略任何字符
+*	参数:	splbuf: 缓冲区  ignore: 忽略字符
+*	返回:	无返回值
+*	备注:	双引号内的字符不会受此限制
+*---------------------------------------------------------------------*/
+void libserial_parse_set_ignore(libserial_parse_buf_t *spbuf, char ignore)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	memset(obj->cfg.ignore, 0x00, sizeof(obj->cfg.ignore));
+	LIBSERIAL_PARSE_MAP_SET(obj->cfg.ignore, ignore);
+	libserial_parse_update_stop(obj);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_divide_set
+*	功能:	设定分隔字符集合, 集合内任意字符都可以结束文本
+*	参数:	splbuf: 缓冲区  set: 分隔字符组成的字符串, 如 " ,=\t" (NULL 或 "" 代表不分隔)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_divide_set(libserial_parse_buf_t *spbuf, const char *set)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	libserial_parse_make_map(obj->cfg.divide, set);
+	libserial_parse_update_stop(obj);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_ignore_set
+*	功能:	设定忽略字符集合, 集合内任意字符都会被忽略
+*	参数:	splbuf: 缓冲区  set: 忽略字符组成的字符串, 如 " \t" (NULL 或 "" 代表不忽略任何字符)
+*	返回:	无返回值
+*	备注:	双引号内的字符不会受此限制
+*---------------------------------------------------------------------*/
+void libserial_parse_set_ignore_set(libserial_parse_buf_t *spbuf, const char *set)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	libserial_parse_make_map(obj->cfg.ignore, set);
+	libserial_parse_update_stop(obj);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_divide
+*	功能:	获取结束上一个文本的分隔字符
+*	参数:	splbuf: 缓冲区
+*	返回:	分隔字符, 因缓冲区满或 libserial_parse_text_finish() 结束的文本返回 '\0'
+*---------------------------------------------------------------------*/
+char libserial_parse_get_divide(libserial_parse_buf_t *spbuf)
+{
+	return get_parse_object(spbuf)->sta.end;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_status
+*	功能:	获取上一个文本的完整状态
+*	参数:	splbuf: 缓冲区
+*	返回:	LIBSERIAL_PARSE_STATUS_OK: 文本完整  LIBSERIAL_PARSE_STATUS_OVERFLOW: 文本因缓冲区已满被截断
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_get_status(libserial_parse_buf_t *spbuf)
+{
+	return get_parse_object(spbuf)->sta.ovf ? LIBSERIAL_PARSE_STATUS_OVERFLOW : LIBSERIAL_PARSE_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_text
+*	功能:	获取上一个文本的地址
+*	参数:	splbuf: 缓冲区
+*	返回:	以 '\0' 结尾的文本, 通常为 spbuf->buf, 挂接文本收集区时位于收集区内
+*---------------------------------------------------------------------*/
+const char *libserial_parse_get_text(libserial_parse_buf_t *spbuf)
+{
+	return get_parse_object(spbuf)->buf.buf;
+}
+
+#ifdef LIBSERIAL_PARSE_GROW
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_grow
+*	功能:	启用缓冲区自动增长, 文本超出缓冲区时按倍数扩大缓冲区直至上限
+*	参数:	splbuf: 由 libserial_parse_create() 创建并已初始化的缓冲区  limit: 缓冲区增长上限
+*	返回:	0: 内存不足或上限小于当前缓冲区大小  >0: 当前可存储最长文本的长度
+*	备注:	解析器对象移到单独申请的内存块, 文本缓冲区随后可以整体 realloc() 而不影响解析器对象
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_set_grow(libserial_parse_buf_t *spbuf, unsigned int limit)
+{
+	parse_object_t *obj = get_parse_object(spbuf), *dst = NULL;
+	char *block = NULL;
+	size_t addr = 0x00;
+
+	if(limit < obj->buf.space || LIBSERIAL_PARSE_COLLECTING(obj) || LIBSERIAL_PARSE_FILTERING(obj)){
+		return 0;
+	}
+
+	// 已启用时只更新上限
+	if(LIBSERIAL_PARSE_GROWABLE(obj)){
+		obj->grow.limit = limit;
+		return obj->buf.space;
+	}
+
+	if((block = (char *)malloc(LIBSERIAL_PARSE_OBJECT_SIZE)) == NULL){
+		return 0;
+	}
+	addr = (size_t)block;
+#if defined(LIBSERIAL_PARSE_ALIGNED)
+	addr = (addr + LIBSERIAL_PARSE_ALIGN - 1) & ~(size_t)(LIBSERIAL_PARSE_ALIGN - 1);
+#endif
+	dst = (parse_object_t *)addr;
+	memcpy(dst, obj, sizeof(parse_object_t));
+#ifdef LIBSERIAL_PARSE_STATS
+	// 运行统计按对象地址对齐, 需要单独复制到新位置
+	memcpy(get_parse_stats(dst), get_parse_stats(obj), sizeof(parse_stats_t));
+#endif
+
+	dst->grow.owner = spbuf;
+	dst->grow.block = block;
+	dst->grow.base  = dst->buf.space;
+	dst->grow.limit = limit;
+	dst->grow.quiet = 0x00;
+	spbuf->obj = dst;
+
+	// 归还文本缓冲区末尾原解析器对象所占的空间
+	libserial_parse_resize(dst, dst->buf.space);
+	return dst->buf.space;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_grow
+*	功能:	获取缓冲区增长上限
+*	参数:	splbuf: 缓冲区
+*	返回:	0: 未启用自动增长  >0: 缓冲区增长上限
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_get_grow(libserial_parse_buf_t *spbuf)
+{
+	return get_parse_object(spbuf)->grow.limit;
+}
+#endif
+
+#ifdef LIBSERIAL_PARSE_TOKENS
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_token_arena
+*	功能:	挂接文本收集区, 此后的文本直接解析到收集区内并被依次保留
+*	参数:	splbuf: 缓冲区  arena: 已重置的文本收集区(NULL 代表解除挂接, 恢复使用 spbuf->buf)
+*	返回:	0: 收集区空间不足或缓冲区已启用自动增长  >0: 当前可存储最长文本的长度
+*	备注:	未完成的文本随之移到新的缓冲区, 超出新缓冲区的部分被截断
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_set_token_arena(libserial_parse_buf_t *spbuf, libserial_parse_token_arena_t *arena)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	char *buf = spbuf->buf;
+	unsigned int space = spbuf->total - LIBSERIAL_PARSE_OBJECT_SIZE;
+
+	// 可增长的缓冲区会被 realloc(), 不能与收集区共用
+	if(LIBSERIAL_PARSE_GROWABLE(obj)){
+		return 0;
+	}
+
+	if(arena){
+		if(arena->used > arena->total || arena->total - arena->used < 2){
+			return 0;
+		}
+		buf   = arena->buf + arena->used;
+		space = arena->total - arena->used;
+	}
+
+	obj->buf.idx = (obj->buf.idx < space - 1) ? obj->buf.idx : space - 1;
+	memmove(buf, obj->buf.buf, obj->buf.idx);
+	buf[obj->buf.idx] = '\0';
+	obj->buf.buf   = buf;
+	obj->buf.space = space;
+	obj->tokens    = arena;
+	return obj->buf.space;
+}
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_token_arena_reset
+*	功能:	清空文本收集区, 时间复杂度 O(1)
+*	参数:	arena: 文本收集区
+*	返回:	无返回值
+*	备注:	挂接的解析器在下一次调用解析接口时重新定位到收集区起始位置
+*---------------------------------------------------------------------*/
+void libserial_parse_token_arena_reset(libserial_parse_token_arena_t *arena)
+{
+	arena->count   = 0x00;
+	arena->used    = 0x00;
+	arena->dropped = 0x00;
+	return ;
+}
+
+#ifdef LIBSERIAL_PARSE_FILTER
+// 行过滤器存储区大小: 匹配结果、状态转移表、前缀长度, 以及编译时使用的失败转移和队列
+#define LIBSERIAL_PARSE_FILTER_SIZE(states, classes)	((states) * ((1 + (classes)) * sizeof(unsigned int) + 3 * sizeof(unsigned short)) + sizeof(unsigned int) - 1)
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_layout
+*	功能:	检查关键字, 统计状态个数上限并建立字符到类别的映射
+*	参数:	patterns: 关键字数组  count: 关键字个数  
+*			cls: 返回字符到类别的映射(256 字节)  classes: 返回字符类别个数
+*	返回:	0: 关键字不合法或状态数超出 65535  >0: 状态个数上限
+*---------------------------------------------------------------------*/
+static unsigned int libserial_parse_filter_layout(const libserial_parse_pattern_t *patterns, unsigned int count, unsigned char *cls, unsigned int *classes)
+{
+	unsigned char map[32] = {0x00};
+	const unsigned char *p = NULL;
+	unsigned int i = 0x00, states = 0x01;
+
+	if(NULL == patterns || 0 == count || count > 0xFFFE){
+		return 0;
+	}
+
+	for(i = 0; i < count; i++){
+		p = (const unsigned char *)patterns[i].text;
+		if(NULL == p || '\0' == p[0] || ('\r' == p[0] && '\0' == p[1])){
+			return 0;
+		}
+		for(; *p; p++){
+			if('\n' == *p || ++states > 0xFFFF){
+				return 0;
+			}
+			LIBSERIAL_PARSE_MAP_SET(map, *p);
+		}
+	}
+
+	// 关键字中出现的字符各为一类, 其余字符都归入第 0 类
+	*classes = 0x01;
+	for(i = 0; i < 256; i++){
+		cls[i] = LIBSERIAL_PARSE_MAP_TEST(map, i) ? (unsigned char)(*classes)++ : 0x00;
+	}
+
+	return states;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_size
+*	功能:	计算编译行过滤器所需的存储区大小
+*	参数:	patterns: 关键字数组  count: 关键字个数
+*	返回:	0: 关键字不合法或状态数超出 65535  >0: 存储区字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_filter_size(const libserial_parse_pattern_t *patterns, unsigned int count)
+{
+	unsigned char cls[256];
+	unsigned int states = 0x00, classes = 0x00;
+
+	if((states = libserial_parse_filter_layout(patterns, count, cls, &classes)) == 0){
+		return 0;
+	}
+	return (unsigned int)LIBSERIAL_PARSE_FILTER_SIZE(states, classes);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_build
+*	功能:	将一组关键字编译为行过滤器
+*	参数:	filter: 行过滤器  patterns: 关键字数组  count: 关键字个数  
+*			mem: 存储区  size: 存储区大小(不小于 libserial_parse_filter_size())
+*	返回:	0: 关键字不合法或存储区不足  >0: 自动机状态个数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_filter_build(libserial_parse_filter_t *filter, const libserial_parse_pattern_t *patterns, unsigned int count, void *mem, unsigned int size)
+{
+	unsigned int states = 0x00, classes = 0x00, n = 0x01, i = 0x00, c = 0x00, s = 0x00, t = 0x00, f = 0x00, shift = 0x00;
+	unsigned int head = 0x00, tail = 0x00, id = 0x00;
+	unsigned short *fail = NULL, *queue = NULL;
+	unsigned char map[32] = {0x00};
+	const unsigned char *p = NULL;
+	size_t addr = (size_t)mem;
+
+	if(NULL == filter || NULL == mem || (states = libserial_parse_filter_layout(patterns, count, filter->cls, &classes)) == 0){
+		return 0;
+	}
+	if(size < LIBSERIAL_PARSE_FILTER_SIZE(states, classes)){
+		return 0;
+	}
+
+	addr = (addr + sizeof(unsigned int) - 1) & ~(size_t)(sizeof(unsigned int) - 1);
+	filter->out   = (unsigned int *)addr;
+	filter->next  = filter->out + states;
+	filter->depth = (unsigned short *)(filter->next + states * classes);
+	fail  = filter->depth + states;
+	queue = fail + states;
+	memset(filter->out, 0x00, states * sizeof(unsigned int));
+	memset(filter->next, 0x00, states * classes * sizeof(unsigned int));
+	filter->depth[0] = 0x00;
+
+	// 建立关键字树, 转移为 0 表示尚无子状态(根状态不会是任何状态的子状态)
+	for(i = 0; i < count; i++){
+		for(s = 0, p = (const unsigned char *)patterns[i].text; *p; p++){
+			c = s * classes + filter->cls[*p];
+			if(0 == filter->next[c]){
+				filter->depth[n] = (unsigned short)(filter->depth[s] + 1);
+				filter->next[c]  = n++;
+			}
+			s = filter->next[c];
+		}
+
+		// 结束于同一状态的关键字保留编号最小者
+		if(!patterns[i].prefix){
+			LIBSERIAL_PARSE_MAP_SET(map, patterns[i].text[0]);
+		}
+		shift = patterns[i].prefix ? 16 : 0;
+		if(0 == ((filter->out[s] >> shift) & 0xFFFF)){
+			filter->out[s] |= (i + 1) << shift;
+		}
+	}
+
+	// 按广度优先顺序计算失败转移, 并将缺失的转移补全, 得到完整的状态转移表
+	// 处理某个状态时其转移表中只有关键字树的子状态, 失败转移指向的状态已处理完毕
+	fail[0] = 0x00;
+	queue[tail++] = 0x00;
+	while(head < tail){
+		s = queue[head++];
+		for(c = 0; c < classes; c++){
+			f = (0 == s) ? 0 : filter->next[fail[s] * classes + c];
+			if((t = filter->next[s * classes + c]) == 0){
+				filter->next[s * classes + c] = f;
+				continue;
+			}
+
+			// 行内关键字沿失败转移继承, 行首关键字只属于自身状态
+			fail[t] = (unsigned short)f;
+			id = filter->out[f] & 0xFFFF;
+			if(id && (0 == (filter->out[t] & 0xFFFF) || id < (filter->out[t] & 0xFFFF))){
+				filter->out[t] = (filter->out[t] & 0xFFFF0000) | id;
+			}
+			queue[tail++] = (unsigned short)t;
+		}
+	}
+
+	// 重新编号使有匹配结果的状态排在最后, 扫描时比较偏移即可判断, 转移表项换算为目标状态在表内的偏移
+	for(i = 0, t = 0; i < n; i++){
+		if(0 == filter->out[i]){
+			queue[i] = (unsigned short)t++;
+		}
+	}
+	filter->match = t * classes;
+	for(i = 0; i < n; i++){
+		if(filter->out[i]){
+			queue[i] = (unsigned short)t++;
+		}
+	}
+	for(i = 0; i < n * classes; i++){
+		filter->next[i] = queue[filter->next[i]] * classes;
+	}
+
+	// 按编号交换各状态的数据, 每次交换至少有一个状态到达新位置
+	for(i = 0; i < n; i++){
+		while((t = queue[i]) != i){
+			for(c = 0; c < classes; c++){
+				f = filter->next[i * classes + c];
+				filter->next[i * classes + c] = filter->next[t * classes + c];
+				filter->next[t * classes + c] = f;
+			}
+			f = filter->out[i];   filter->out[i]   = filter->out[t];   filter->out[t]   = f;
+			f = filter->depth[i]; filter->depth[i] = filter->depth[t]; filter->depth[t] = (unsigned short)f;
+			queue[i] = queue[t];
+			queue[t] = (unsigned short)t;
+		}
+	}
+
+	// 不在文本开头时, 初始状态下只有换行符和行内关键字的首字符需要停下, 字符过多时不做批量跳过
+	filter->skip[0] = '\n';
+	for(i = 0, c = 0x01; i < 256; i++){
+		if(LIBSERIAL_PARSE_MAP_TEST(map, i) && c++ < sizeof(filter->skip)){
+			filter->skip[c - 1] = (char)i;
+		}
+	}
+	filter->nskip = (unsigned char)((c <= sizeof(filter->skip)) ? c : 0);
+
+	filter->states  = n;
+	filter->classes = classes;
+	return n;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_filter
+*	功能:	挂接行过滤器, 此后以换行符为终止符的接口只返回包含任一关键字的文本
+*	参数:	splbuf: 缓冲区  filter: 已编译的行过滤器(NULL 代表解除挂接)
+*	返回:	0: 缓冲区已启用自动增长  >0: 可存储最长文本的长度
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_set_filter(libserial_parse_buf_t *spbuf, const libserial_parse_filter_t *filter)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	// 可增长的缓冲区不在固定长度处截断文本, 批量接口无法在拷贝之前判定文本边界
+	if(LIBSERIAL_PARSE_GROWABLE(obj)){
+		return 0;
+	}
+
+	obj->flt.filter = filter;
+	obj->flt.state  = 0x00;
+	obj->flt.hit    = 0x00;
+	obj->flt.last   = 0x00;
+
+	// 已缓存的部分文本按缓冲区内容匹配
+	if(filter && obj->buf.idx > 0){
+		libserial_parse_filter_scan(obj, obj->buf.buf, obj->buf.idx, 0);
+	}
+	return obj->buf.space;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_match
+*	功能:	获取上一个返回的文本匹配到的关键字编号
+*	参数:	splbuf: 缓冲区
+*	返回:	-1: 未挂接行过滤器或尚未返回文本  >=0: 关键字编号
+*---------------------------------------------------------------------*/
+int libserial_parse_get_match(libserial_parse_buf_t *spbuf)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	return obj->flt.filter ? (int)obj->flt.last - 1 : -1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_filter
+*	功能:	获取挂接的行过滤器
+*	参数:	splbuf: 缓冲区
+*	返回:	NULL: 未挂接行过滤器  其他: 行过滤器
+*---------------------------------------------------------------------*/
+const libserial_parse_filter_t *libserial_parse_get_filter(libserial_parse_buf_t *spbuf)
+{
+	return get_parse_object(spbuf)->flt.filter;
+}
+#endif
+
+#ifdef LIBSERIAL_PARSE_INTERN
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_intern_size
+*	功能:	计算行驻留缓存所需的存储区大小
+*	参数:	slots: 槽位个数  width: 可驻留文本的最大长度
+*	返回:	0: 参数不合法或超出 4GB  >0: 存储区字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_intern_size(unsigned int slots, unsigned int width)
+{
+	unsigned long long size = 0x00;
+
+	if(slots < LIBSERIAL_PARSE_INTERN_WAYS || 0 == width){
+		return 0;
+	}
+	size = (unsigned long long)slots * (sizeof(libserial_parse_intern_slot_t) + width) + sizeof(unsigned int) - 1;
+	return (size > 0xFFFFFFFFULL) ? 0 : (unsigned int)size;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_intern_init
+*	功能:	在存储区内建立(或清空)行驻留缓存
+*	参数:	cache: 行驻留缓存  slots: 槽位个数  width: 可驻留文本的最大长度
+*			mem: 存储区  size: 存储区大小
+*	返回:	0: 参数不合法或存储区不足  >0: 实际槽位个数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_intern_init(libserial_parse_intern_t *cache, unsigned int slots, unsigned int width, void *mem, unsigned int size)
+{
+	unsigned int sets = 0x01, need = 0x00;
+	size_t addr = (size_t)mem;
+
+	if(NULL == cache || NULL == mem || libserial_parse_intern_size(slots, width) == 0){
+		return 0;
+	}
+
+	// 组数取 2 的幂, 按哈希值的低位选组
+	while(sets <= slots / LIBSERIAL_PARSE_INTERN_WAYS / 2){
+		sets *= 2;
+	}
+	slots = sets * LIBSERIAL_PARSE_INTERN_WAYS;
+	if((need = libserial_parse_intern_size(slots, width)) == 0 || size < need){
+		return 0;
+	}
+
+	addr = (addr + sizeof(unsigned int) - 1) & ~(size_t)(sizeof(unsigned int) - 1);
+	cache->slot  = (libserial_parse_intern_slot_t *)addr;
+	cache->text  = (char *)(cache->slot + slots);
+	memset(cache->slot, 0x00, slots * sizeof(libserial_parse_intern_slot_t));
+	cache->slots = slots;
+	cache->width = width;
+	cache->mask  = sets - 1;
+	cache->clock = 0x00;
+	cache->hits  = 0x00;
+	cache->misses    = 0x00;
+	cache->evictions = 0x00;
+	return slots;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_intern
+*	功能:	挂接行驻留缓存
+*	参数:	splbuf: 缓冲区  cache: 行驻留缓存(NULL 代表解除挂接)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_intern(libserial_parse_buf_t *spbuf, libserial_parse_intern_t *cache)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	obj->itn.cache = cache;
+	obj->itn.hash  = LIBSERIAL_PARSE_INTERN_SEED;
+	obj->itn.pos   = 0x00;
+	obj->itn.id    = -1;
+	obj->itn.seen  = 0x00;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_intern
+*	功能:	获取上一个返回的文本的驻留编号
+*	参数:	splbuf: 缓冲区  seen: 返回该文本此前是否已驻留(可为 NULL)
+*	返回:	-1: 未挂接驻留缓存、尚未返回文本或文本未驻留  >=0: 驻留编号
+*---------------------------------------------------------------------*/
+int libserial_parse_get_intern(libserial_parse_buf_t *spbuf, int *seen)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	if(seen){
+		*seen = obj->itn.cache ? obj->itn.seen : 0;
+	}
+	return obj->itn.cache ? obj->itn.id : -1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_intern_cache
+*	功能:	获取挂接的行驻留缓存
+*	参数:	splbuf: 缓冲区
+*	返回:	NULL: 未挂接行驻留缓存  其他: 行驻留缓存
+*---------------------------------------------------------------------*/
+libserial_parse_intern_t *libserial_parse_get_intern_cache(libserial_parse_buf_t *spbuf)
+{
+	return get_parse_object(spbuf)->itn.cache;
+}
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_shift
+*	功能:	设置大小写字母转换
+*	参数:	splbuf: 缓冲区  shift: 0:不做转换 1:转换为小写字母 2:转换为大写字母
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_shift(libserial_parse_buf_t *spbuf, char shift)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	// 转换表在设置时选定一次, 解析时直接查表
+	if(LIBSERIAL_PARSE_SHIFT_NORMAL == shift){
+		obj->cfg.shift = LIBSERIAL_PARSE_SHIFT_NORMAL;
+		obj->cfg.table = libserial_parse_same_table;
+	}else if(LIBSERIAL_PARSE_SHIFT_LOWER == shift){
+		obj->cfg.shift = LIBSERIAL_PARSE_SHIFT_LOWER;
+		obj->cfg.table = libserial_parse_lower_table;
+	}else{
+		obj->cfg.shift = LIBSERIAL_PARSE_SHIFT_UPPER;
+		obj->cfg.table = libserial_parse_upper_table;
+	}
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_shift_table
+*	功能:	设置用户提供的字符转换表
+*	参数:	splbuf: 缓冲区  table: 256 字节转换表(NULL 代表不做转换)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_shift_table(libserial_parse_buf_t *spbuf, const unsigned char *table)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	if(NULL == table){
+		libserial_parse_set_shift(spbuf, LIBSERIAL_PARSE_SHIFT_NORMAL);
+		return ;
+	}
+
+	obj->cfg.shift = LIBSERIAL_PARSE_SHIFT_TABLE;
+	obj->cfg.table = table;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_escape
+*	功能:	设置是否解码双引号内的转义序列
+*	参数:	splbuf: 缓冲区  escape: 0:不解码(默认) 1:解码
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_escape(libserial_parse_buf_t *spbuf, char escape)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	obj->cfg.escape = (0 != escape);
+	libserial_parse_update_stop(obj);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_config
+*	功能:	复制另一个解析器的分隔、忽略、大小写转换和转义配置
+*	参数:	splbuf: 缓冲区  src: 已配置好的解析器缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_config(libserial_parse_buf_t *spbuf, libserial_parse_buf_t *src)
+{
+	get_parse_object(spbuf)->cfg = get_parse_object(src)->cfg;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_overflow
+*	功能:	处理文本长度达到缓冲区大小的情况
+*	参数:	obj: 解析器对象
+*	返回:	0: 缓冲区已扩大或正在丢弃超出上限的数据  	>0:返回被截断的文本长度(不包含 '\0')
+*	备注:	可增长的缓冲区先按倍数扩大, 达到上限后丢弃剩余数据直至分隔字符;
+*			固定大小的缓冲区直接返回被截断的文本, 剩余数据作为下一个文本
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_overflow(parse_object_t *obj)
+{
+#ifdef LIBSERIAL_PARSE_GROW
+	if(LIBSERIAL_PARSE_GROWABLE(obj)){
+		if(!obj->sta.full && 0 == libserial_parse_grow(obj)){
+			LIBSERIAL_PARSE_STAT_ADD(obj, overflows, 1);
+			obj->sta.full = 1;
+		}
+		return 0;
+	}
+#endif
+
+	LIBSERIAL_PARSE_STAT_ADD(obj, overflows, 1);
+	LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, 0 != obj->sta.dqu);
+	obj->sta.end = '\0';
+	obj->sta.ovf = 1;
+	obj->buf.idx = 0;
+	obj->sta.dqu = 0;
+	obj->sta.esc = LIBSERIAL_PARSE_ESC_NONE;
+	return obj->buf.len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_store
+*	功能:	向缓冲区存储一个字符并检查长度
+*	参数:	obj: 解析器对象		indata: 需要存储的字符
+*	返回:	0: 正在解析  	>0:缓冲区已满, 返回文本长度(不包含 '\0')
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_store(parse_object_t *obj, char indata)
+{
+	// 复制数据
+	if(obj->buf.idx < obj->buf.space - 1){
+		obj->buf.buf[obj->buf.idx+1] = '\0';
+		obj->buf.buf[obj->buf.idx++] = indata;
+		obj->buf.len = obj->buf.idx;
+	}
+	
+	// 长度检查
+	if(obj->buf.idx >= obj->buf.space - 1){
+		return libserial_parse_overflow(obj);
+	}
+	
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_hex
+*	功能:	将十六进制数字转换为数值
+*	参数:	ch: 字符
+*	返回:	-1: 不是十六进制数字  0~15: 数值
+*---------------------------------------------------------------------*/
+static inline int libserial_parse_hex(char ch)
+{
+	if(ch >= '0' && ch <= '9'){
+		return ch - '0';
+	}
+	if((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f'){
+		return (ch | 0x20) - 'a' + 10;
+	}
+	return -1;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_escape
+*	功能:	逐字节解码双引号内的转义序列(\n \r \t \xNN, 其余 \c 解码为 c 本身, 如 \" 和 \\)
+*	参数:	obj: 解析器对象		indata: 输入数据, 解码完成时返回解码得到的字符
+*	返回:	0: 字符属于转义序列且尚未解码完成  1: 解码完成  2: 格式错误的 \x 转义被丢弃, 该字符按普通字符处理
+*---------------------------------------------------------------------*/
+static inline int libserial_parse_escape(parse_object_t *obj, char *indata)
+{
+	int val = 0x00;
+
+	switch(obj->sta.esc){
+	case LIBSERIAL_PARSE_ESC_NONE:
+		obj->sta.esc = LIBSERIAL_PARSE_ESC_START;
+		return 0;
+	case LIBSERIAL_PARSE_ESC_START:
+		obj->sta.esc = LIBSERIAL_PARSE_ESC_NONE;
+		switch(*indata){
+		case 'n':	*indata = '\n';	break;
+		case 'r':	*indata = '\r';	break;
+		case 't':	*indata = '\t';	break;
+		case 'x':	obj->sta.esc = LIBSERIAL_PARSE_ESC_HEX1;	return 0;
+		default:	break;
+		}
+		return 1;
+	case LIBSERIAL_PARSE_ESC_HEX1:
+		if((val = libserial_parse_hex(*indata)) < 0){
+			obj->sta.esc = LIBSERIAL_PARSE_ESC_NONE;
+			return 2;
+		}
+		obj->sta.hex = (unsigned char)val;
+		obj->sta.esc = LIBSERIAL_PARSE_ESC_HEX2;
+		return 0;
+	default:
+		obj->sta.esc = LIBSERIAL_PARSE_ESC_NONE;
+		if((val = libserial_parse_hex(*indata)) < 0){
+			return 2;
+		}
+		*indata = (char)((obj->sta.hex << 4) | val);
+		return 1;
+	}
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_text_byte
+*	功能:	解析以指定符号分隔或跳过的文本(单字节处理核心)
+*	参数:	obj: 解析器对象		indata: 输入数据
+*	返回:	0: 正在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_text_byte(parse_object_t *obj, char indata)
+{
+	// 双引号内的转义序列, 解码得到的字符直接存储(分隔字符仍然结束文本)
+	if((obj->sta.esc || ('\\' == indata && obj->sta.dqu && obj->cfg.escape)) && !LIBSERIAL_PARSE_MAP_TEST(obj->cfg.divide, indata)){
+		switch(libserial_parse_escape(obj, &indata)){
+		case 0:
+			return 0;
+		case 1:
+			return libserial_parse_store(obj, indata);
+		default:
+			break;
+		}
+	}
+
+	// 对数据进行预处理
+	if(libserial_parse_preprocess(obj, indata) == 1){
+		LIBSERIAL_PARSE_STAT_ADD(obj, ignored, '\"' != indata);
+		return 0;
+	}
+	
+	// 匹配分隔符
+	if(LIBSERIAL_PARSE_MAP_TEST(obj->cfg.divide, indata)){
+		LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, 0 != obj->sta.dqu);
+		obj->sta.end = indata;
+		obj->sta.ovf = obj->sta.full;
+		obj->sta.full = 0;
+		obj->buf.len = obj->buf.idx;
+		obj->buf.idx = 0;
+		obj->sta.dqu = 0;
+		obj->sta.esc = LIBSERIAL_PARSE_ESC_NONE;
+		return obj->buf.len;
+	}
+
+	// 大小写转换检查
+	indata = libserial_parse_shift_convert(obj, indata);
+
+	// 复制数据并检查长度
+	return libserial_parse_store(obj, indata);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_text_nl_byte
+*	功能:	解析以换行符为终止符的文本(单字节处理核心)
+*	参数:	obj: 解析器对象		indata: 输入数据
+*	返回:	0: 正在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_text_nl_byte(parse_object_t *obj, char indata)
+{
+	// 检查换行字符
+	if('\n' == indata)
+	{
+		if(obj->buf.idx && '\r' == obj->buf.buf[obj->buf.idx-1]){
+			obj->buf.idx--;
+			obj->buf.buf[obj->buf.idx] = '\0';
+		}
+		LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, 0 != obj->sta.dqu);
+		obj->sta.end = '\n';
+		obj->sta.ovf = obj->sta.full;
+		obj->sta.full = 0;
+		obj->buf.len = obj->buf.idx;
+		obj->buf.idx = 0;
+		obj->sta.dqu = 0;
+		return obj->buf.len;
+	}
+
+	// 预处理和大小写检查转换
+	libserial_parse_preprocess(obj, indata);
+	indata = libserial_parse_shift_convert(obj, indata);
+
+	// 拷贝数据并检查长度
+	return libserial_parse_store(obj, indata);
+}
+
+#ifdef LIBSERIAL_PARSE_FILTER
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_text_nl_filter
+*	功能:	解析以换行符为终止符的文本并进行行过滤(单字节处理核心)
+*	参数:	obj: 解析器对象		indata: 输入数据
+*	返回:	0: 正在解析或文本未匹配  	>0:解析成功, 返回文本长度(不包含 '\0')
+*	备注:	单字节输入无法预知文本是否匹配, 数据仍需逐字节缓存
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_text_nl_filter(parse_object_t *obj, char indata)
+{
+	unsigned int len = 0x00;
+
+	if(!obj->flt.hit){
+		libserial_parse_filter_scan(obj, &indata, 1, obj->buf.idx);
+	}
+	len = libserial_parse_text_nl_byte(obj, indata);
+	return (len > 0 || '\n' == indata) ? libserial_parse_filter_end(obj, len) : 0;
+}
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_room
+*	功能:	计算缓冲区在触发长度检查前还能连续存储的字节数
+*	参数:	obj: 解析器对象		size: 剩余输入数据长度
+*	返回:	可以批量拷贝的最大字节数
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_room(parse_object_t *obj, unsigned int size)
+{
+	unsigned int room = (obj->buf.idx < obj->buf.space - 1) ? obj->buf.space - 1 - obj->buf.idx : 0;
+	return (room < size) ? room : size;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_copy_run
+*	功能:	批量拷贝一段不含任何特殊字符的连续数据
+*	参数:	obj: 解析器对象		data: 输入数据	size: 数据长度(不超过 libserial_parse_room())
+*	返回:	0: 正在解析  	>0:缓冲区已满, 返回文本长度(不包含 '\0')
+*	备注:	与逐字节拷贝等价, 但只在末尾写入一次 '\0'
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_copy_run(parse_object_t *obj, const char *data, unsigned int size)
+{
+	char *dst = obj->buf.buf + obj->buf.idx;
+
+	// 拷贝数据(双引号内的字符不进行转换)
+	if(LIBSERIAL_PARSE_SHIFT_NORMAL != obj->cfg.shift && !obj->sta.dqu){
+		libserial_parse_translate(obj, dst, data, size);
+	}else{
+		memcpy(dst, data, size);
+	}
+	obj->buf.idx += size;
+	obj->buf.buf[obj->buf.idx] = '\0';
+	obj->buf.len = obj->buf.idx;
+
+	// 长度检查
+	if(obj->buf.idx >= obj->buf.space - 1){
+		return libserial_parse_overflow(obj);
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_text
+*	功能:	解析以指定符号分隔或跳过的文本
+*	参数:	splbuf: 缓冲区  indata: 输入数据
+*	返回:	0: 正在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+*	备注:	没有设定分隔符则会一直返回0, 数据超出缓存长度会返回解析完成
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_text(libserial_parse_buf_t *spbuf, char indata)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	unsigned int len = 0x00;
+
+	libserial_parse_call_begin(obj);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+	len = libserial_parse_text_byte(obj, indata);
+	LIBSERIAL_PARSE_STAT_END(obj, 1, len, 0);
+	libserial_parse_call_end(obj, len);
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_text_nl  (nl -> new line)
+*	功能:	解析以换行符为终止符的文本(支持 '\n' 和 '\r\n')
+*	参数:	splbuf: 缓冲区  indata: 输入数据
+*	返回:	0: 正在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+*	备注:	不受 libserial_parse_set_divide()\libserial_parse_set_ignore() 影响
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_text_nl(libserial_parse_buf_t *spbuf, char indata)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	unsigned int len = 0x00;
+
+	libserial_parse_call_begin(obj);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+#ifdef LIBSERIAL_PARSE_FILTER
+	len = obj->flt.filter ? libserial_parse_text_nl_filter(obj, indata) : libserial_parse_text_nl_byte(obj, indata);
+#else
+	len = libserial_parse_text_nl_byte(obj, indata);
+#endif
+	LIBSERIAL_PARSE_STAT_END(obj, 1, len, 0);
+	LIBSERIAL_PARSE_INTERN_BYTE(obj, len);
+	libserial_parse_call_end(obj, len);
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_block
+*	功能:	批量解析以指定符号分隔或跳过的文本(数据块处理核心)
+*	参数:	obj: 解析器对象  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_feed_block(parse_object_t *obj, const char *data, unsigned int size, unsigned int *used)
+{
+	unsigned int i = 0x00, n = 0x00, len = 0x00;
+
+	while(i < size && 0 == len){
+		// 快速路径: 非文本开头时批量拷贝不含双引号、忽略字符和分隔字符的数据
+		if(obj->buf.idx > 0 && !obj->sta.esc && (n = libserial_parse_room(obj, size - i)) > 0){
+			n = libserial_parse_scan_stop(obj, data + i, n);
+			if(n > 0){
+				len = libserial_parse_copy_run(obj, data + i, n);
+				i += n;
+				continue;
+			}
+		}
+
+		// 特殊字符逐字节处理
+		len = libserial_parse_text_byte(obj, data[i++]);
+	}
+
+	*used = i;
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_nl_block
+*	功能:	批量解析以换行符为终止符的文本(数据块处理核心)
+*	参数:	obj: 解析器对象  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_feed_nl_block(parse_object_t *obj, const char *data, unsigned int size, unsigned int *used)
+{
+	unsigned int i = 0x00, n = 0x00, len = 0x00;
+
+	while(i < size && 0 == len){
+#ifdef LIBSERIAL_PARSE_GROW
+		// 文本已达到增长上限: 批量丢弃不含换行符和双引号的数据
+		if(obj->sta.full && (n = libserial_parse_scan(data + i, size - i, "\n\"", 2)) > 0){
+			i += n;
+			continue;
+		}
+#endif
+
+		// 快速路径: 批量拷贝不含换行符和双引号的数据
+		if((n = libserial_parse_room(obj, size - i)) > 0){
+			n = libserial_parse_scan(data + i, n, "\n\"", 2);
+			if(n > 0){
+				len = libserial_parse_copy_run(obj, data + i, n);
+				i += n;
+				continue;
+			}
+		}
+
+		// 特殊字符逐字节处理
+		len = libserial_parse_text_nl_byte(obj, data[i++]);
+	}
+
+	*used = i;
+	return len;
+}
+
+#ifdef LIBSERIAL_PARSE_FILTER
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_nl_filter
+*	功能:	批量解析以换行符为终止符的文本并进行行过滤(数据块处理核心)
+*	参数:	obj: 解析器对象  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回匹配的文本长度(不包含 '\0')
+*	备注:	匹配之前只运行自动机, 完整位于数据块内且不匹配的文本不会被拷贝
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_feed_nl_filter(parse_object_t *obj, const char *data, unsigned int size, unsigned int *used)
+{
+	unsigned int i = 0x00, n = 0x00, room = 0x00, len = 0x00;
+
+	while(i < size && 0 == len){
+		if(!obj->flt.hit){
+			room = libserial_parse_room(obj, size - i);
+			n = libserial_parse_filter_scan(obj, data + i, room, obj->buf.idx);
+			if(!obj->flt.hit && n < room){
+				libserial_parse_filter_skip(obj, data + i, n, '\n');
+				i += n + 1;
+				continue;
+			}
+			if(!obj->flt.hit && obj->buf.idx + n >= obj->buf.space - 1){
+				libserial_parse_filter_skip(obj, data + i, n, '\0');
+				i += n;
+				continue;
+			}
+		}
+
+		// 已匹配或文本跨越数据块: 按正常路径拷贝(自动机已处理过的数据不再扫描)
+		len = libserial_parse_feed_nl_block(obj, data + i, size - i, &n);
+		i += n;
+	}
+
+	*used = i;
+	return (len > 0) ? libserial_parse_filter_end(obj, len) : 0;
+}
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed
+*	功能:	批量解析以指定符号分隔或跳过的文本, 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+*	备注:	解析结果与逐字节调用 libserial_parse_text() 完全一致, 
+*			解析完成时从 data + *used 处继续调用即可
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	unsigned int n = 0x00, len = 0x00;
+
+	libserial_parse_call_begin(obj);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+	len = libserial_parse_feed_block(obj, data, size, &n);
+	LIBSERIAL_PARSE_STAT_END(obj, n, len, 1);
+	libserial_parse_call_end(obj, len);
+	if(used){
+		*used = n;
+	}
+	
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_nl  (nl -> new line)
+*	功能:	批量解析以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+*	备注:	解析结果与逐字节调用 libserial_parse_text_nl() 完全一致, 
+*			解析完成时从 data + *used 处继续调用即可
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed_nl(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	unsigned int n = 0x00, len = 0x00;
+
+	libserial_parse_call_begin(obj);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+#ifdef LIBSERIAL_PARSE_FILTER
+	len = obj->flt.filter ? libserial_parse_feed_nl_filter(obj, data, size, &n) : libserial_parse_feed_nl_block(obj, data, size, &n);
+#else
+	len = libserial_parse_feed_nl_block(obj, data, size, &n);
+#endif
+	LIBSERIAL_PARSE_STAT_END(obj, n, len, 1);
+	LIBSERIAL_PARSE_INTERN_BLOCK(obj, obj->buf.buf, len);
+	libserial_parse_call_end(obj, len);
+	if(used){
+		*used = n;
+	}
+	
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_span_block
+*	功能:	零拷贝方式批量解析以指定符号分隔或跳过的文本(数据块处理核心)
+*	参数:	obj: 解析器对象  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数  span: 返回文本位置
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_feed_span_block(parse_object_t *obj, const char *data, unsigned int size, unsigned int *used, libserial_parse_span_t *span)
+{
+	unsigned int i = 0x00, n = 0x00, limit = 0x00, len = 0x00;
+	unsigned int room = obj->buf.space - 1;
+	char ch = 0x00;
+
+	// 零拷贝路径: 文本从本数据块开始且不需要改写
+	while(i < size && 0 == obj->buf.idx && !obj->sta.dqu && room > 0 && LIBSERIAL_PARSE_SHIFT_NORMAL == obj->cfg.shift && !LIBSERIAL_PARSE_COLLECTING(obj)){
+		// 跳过文本开头的空格和忽略字符(与预处理顺序一致)
+		for(limit = i; i < size && '\"' != data[i] && (' ' == data[i] || LIBSERIAL_PARSE_MAP_TEST(obj->cfg.ignore, data[i])); i++);
+		LIBSERIAL_PARSE_STAT_ADD(obj, ignored, i - limit);
+		if(i >= size){
+			break;
+		}
+
+		// 查找第一个特殊字符, 只有分隔字符结束的文本或缓冲区长度的文本可以直接引用
+		limit = (room < size - i) ? room : size - i;
+		n = libserial_parse_scan_stop(obj, data + i, limit);
+		ch = (n < limit) ? data[i + n] : 0x00;
+		if(n < limit && LIBSERIAL_PARSE_MAP_TEST(obj->cfg.divide, ch) && '\"' != ch && !LIBSERIAL_PARSE_MAP_TEST(obj->cfg.ignore, ch)){
+			obj->sta.end = ch;
+			obj->sta.ovf = 0;
+			obj->buf.len = n;
+			span->ptr = data + i;
+			span->len = n;
+			i += n + 1;
+			if((len = n) > 0){
+				break;
+			}
+			continue;
+		}
+		if(n == limit && limit == room && !LIBSERIAL_PARSE_GROWABLE(obj)){
+			LIBSERIAL_PARSE_STAT_ADD(obj, overflows, 1);
+			obj->sta.end = '\0';
+			obj->sta.ovf = 1;
+			obj->buf.len = n;
+			span->ptr = data + i;
+			span->len = n;
+			i += n;
+			len = n;
+			break;
+		}
+		
+		// 需要改写、跨越数据块或需要扩大缓冲区的文本转入拷贝路径
+		break;
+	}
+
+	// 拷贝路径
+	if(0 == len && i < size){
+		len = libserial_parse_feed_block(obj, data + i, size - i, &n);
+		span->ptr = obj->buf.buf;
+		span->len = len;
+		i += n;
+	}
+
+	*used = i;
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_span
+*	功能:	零拷贝方式批量解析以指定符号分隔或跳过的文本, 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)  span: 返回文本位置
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度
+*	备注:	完整位于数据块内且无需改写(无双引号、忽略字符, 未启用大小写转换)的文本
+*			直接指向 data, 不以 '\0' 结尾; 其余文本指向内部缓冲区 spbuf->buf
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed_span(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used, libserial_parse_span_t *span)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	unsigned int n = 0x00, len = 0x00;
+
+	libserial_parse_call_begin(obj);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+	len = libserial_parse_feed_span_block(obj, data, size, &n, span);
+	LIBSERIAL_PARSE_STAT_END(obj, n, len, 1);
+	libserial_parse_call_end(obj, len);
+	if(used){
+		*used = n;
+	}
+	
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_nl_span_block
+*	功能:	零拷贝方式批量解析以换行符为终止符的文本(数据块处理核心)
+*	参数:	obj: 解析器对象  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数  span: 返回文本位置
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_feed_nl_span_block(parse_object_t *obj, const char *data, unsigned int size, unsigned int *used, libserial_parse_span_t *span)
+{
+	unsigned int i = 0x00, n = 0x00, limit = 0x00, len = 0x00;
+	unsigned int room = obj->buf.space - 1;
+
+	// 零拷贝路径: 文本从本数据块开始且不需要改写
+	while(i < size && 0 == obj->buf.idx && room > 0 && LIBSERIAL_PARSE_SHIFT_NORMAL == obj->cfg.shift && !LIBSERIAL_PARSE_COLLECTING(obj)){
+		limit = (room < size - i) ? room : size - i;
+#ifdef LIBSERIAL_PARSE_FILTER
+		if(obj->flt.filter){
+			// 行过滤: 不匹配的文本直接跳过, 匹配后继续查找换行符
+			n = libserial_parse_filter_scan(obj, data + i, limit, 0);
+			if(!obj->flt.hit && n < limit){
+				libserial_parse_filter_skip(obj, data + i, n, '\n');
+				i += n + 1;
+				continue;
+			}
+			if(!obj->flt.hit && limit == room){
+				libserial_parse_filter_skip(obj, data + i, n, '\0');
+				i += n;
+				continue;
+			}
+			if(!obj->flt.hit){
+				// 跨越数据块的文本需缓存, 已扫描的数据不含换行符也不会触发缓冲区满
+				libserial_parse_feed_nl_block(obj, data + i, size - i, &n);
+				i += n;
+				break;
+			}
+			n += libserial_parse_scan(data + i + n, limit - n, "\n", 1);
+		}else{
+			n = libserial_parse_scan(data + i, limit, "\n", 1);
+		}
+#else
+		n = libserial_parse_scan(data + i, limit, "\n", 1);
+#endif
+		if(n < limit){
+			len = (n > 0 && '\r' == data[i + n - 1]) ? n - 1 : n;
+			LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, libserial_parse_stats_dqu(data + i, n));
+			obj->sta.end = '\n';
+			obj->sta.ovf = 0;
+			obj->buf.len = len;
+			obj->sta.dqu = 0;
+			span->ptr = data + i;
+			span->len = len;
+			i += n + 1;
+			if(len > 0){
+				break;
+			}
+			continue;
+		}
+		if(limit == room && !LIBSERIAL_PARSE_GROWABLE(obj)){
+			LIBSERIAL_PARSE_STAT_ADD(obj, overflows, 1);
+			LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, libserial_parse_stats_dqu(data + i, n));
+			obj->sta.end = '\0';
+			obj->sta.ovf = 1;
+			obj->buf.len = n;
+			obj->sta.dqu = 0;
+			span->ptr = data + i;
+			span->len = n;
+			i += n;
+			len = n;
+			break;
+		}
+
+		// 跨越数据块或需要扩大缓冲区的文本转入拷贝路径
+		break;
+	}
+
+#ifdef LIBSERIAL_PARSE_FILTER
+	// 零拷贝返回的文本已匹配, 结束本文本的过滤状态
+	if(len > 0 && obj->flt.filter){
+		libserial_parse_filter_end(obj, len);
+	}
+#endif
+
+	// 拷贝路径
+	if(0 == len && i < size){
+#ifdef LIBSERIAL_PARSE_FILTER
+		len = obj->flt.filter ? libserial_parse_feed_nl_filter(obj, data + i, size - i, &n) : libserial_parse_feed_nl_block(obj, data + i, size - i, &n);
+#else
+		len = libserial_parse_feed_nl_block(obj, data + i, size - i, &n);
+#endif
+		span->ptr = obj->buf.buf;
+		span->len = len;
+		i += n;
+	}
+
+	*used = i;
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_nl_span  (nl -> new line)
+*	功能:	零拷贝方式批量解析以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)  span: 返回文本位置
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度
+*	备注:	完整位于数据块内且未启用大小写转换的文本直接指向 data, 不以 '\0' 结尾;
+*			其余文本指向内部缓冲区 spbuf->buf
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed_nl_span(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used, libserial_parse_span_t *span)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	unsigned int n = 0x00, len = 0x00;
+
+	libserial_parse_call_begin(obj);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+	len = libserial_parse_feed_nl_span_block(obj, data, size, &n, span);
+	LIBSERIAL_PARSE_STAT_END(obj, n, len, 1);
+	LIBSERIAL_PARSE_INTERN_BLOCK(obj, span->ptr, len);
+	libserial_parse_call_end(obj, len);
+	if(used){
+		*used = n;
+	}
+	
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_emit
+*	功能:	将得到的文本交给事件回调
+*	参数:	obj: 解析器对象  handler: 事件回调  ptr: 文本地址  len: 文本长度
+*	返回:	回调的返回值
+*---------------------------------------------------------------------*/
+static inline int libserial_parse_emit(parse_object_t *obj, const libserial_parse_handler_t *handler, const char *ptr, unsigned int len)
+{
+	if(obj->sta.ovf && handler->on_overflow){
+		return handler->on_overflow(handler->ctx, ptr, len, obj->sta.end);
+	}
+	return handler->on_token(handler->ctx, ptr, len, obj->sta.end);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push
+*	功能:	批量解析以指定符号分隔或跳过的文本, 每得到一个文本即在解析循环内调用回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗  	其他: 回调返回的非 0 值, 解析在该文本之后停止
+*	备注:	运行统计按每个文本之间的数据段分别更新, 回调期间不处于统计更新状态
+*---------------------------------------------------------------------*/
+int libserial_parse_push(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler, const char *data, unsigned int size, unsigned int *used)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	libserial_parse_span_t span = {NULL, 0x00};
+	unsigned int i = 0x00, n = 0x00, len = 0x00;
+	int ret = 0x00;
+
+	while(i < size && 0 == ret){
+		libserial_parse_call_begin(obj);
+		LIBSERIAL_PARSE_STAT_BEGIN(obj);
+		len = libserial_parse_feed_span_block(obj, data + i, size - i, &n, &span);
+		LIBSERIAL_PARSE_STAT_END(obj, n, len, 1);
+		libserial_parse_call_end(obj, len);
+		i += n;
+		if(len > 0){
+			ret = libserial_parse_emit(obj, handler, span.ptr, len);
+		}
+	}
+
+	if(used){
+		*used = i;
+	}
+
+	return ret;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push_nl  (nl -> new line)
+*	功能:	批量解析以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 每得到一个文本即在解析循环内调用回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗  	其他: 回调返回的非 0 值, 解析在该文本之后停止
+*	备注:	运行统计按每个文本之间的数据段分别更新, 回调期间不处于统计更新状态
+*---------------------------------------------------------------------*/
+int libserial_parse_push_nl(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler, const char *data, unsigned int size, unsigned int *used)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	libserial_parse_span_t span = {NULL, 0x00};
+	unsigned int i = 0x00, n = 0x00, len = 0x00;
+	int ret = 0x00;
+
+	while(i < size && 0 == ret){
+		libserial_parse_call_begin(obj);
+		LIBSERIAL_PARSE_STAT_BEGIN(obj);
+		len = libserial_parse_feed_nl_span_block(obj, data + i, size - i, &n, &span);
+		LIBSERIAL_PARSE_STAT_END(obj, n, len, 1);
+		LIBSERIAL_PARSE_INTERN_BLOCK(obj, span.ptr, len);
+		libserial_parse_call_end(obj, len);
+		i += n;
+		if(len > 0){
+			ret = libserial_parse_emit(obj, handler, span.ptr, len);
+		}
+	}
+
+	if(used){
+		*used = i;
+	}
+
+	return ret;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_unescape
+*	功能:	解码反斜杠之后的转义序列(规则与 libserial_parse_escape() 一致)
+*	参数:	data: 反斜杠之后的数据  size: 数据长度  ch: 返回解码得到的字符  out: 返回是否得到字符
+*	返回:	转义序列消耗的字节数(不包含反斜杠)
+*	备注:	格式错误的 \x 转义及数据末尾的反斜杠被丢弃, 其后的字符按普通字符处理
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_unescape(const char *data, unsigned int size, char *ch, unsigned int *out)
+{
+	int hi = 0x00, lo = 0x00;
+
+	*out = 0x00;
+	if(0 == size){
+		return 0;
+	}
+	if('x' != data[0]){
+		*ch  = ('n' == data[0]) ? '\n' : ('r' == data[0]) ? '\r' : ('t' == data[0]) ? '\t' : data[0];
+		*out = 1;
+		return 1;
+	}
+	if(size < 2 || (hi = libserial_parse_hex(data[1])) < 0){
+		return 1;
+	}
+	if(size < 3 || (lo = libserial_parse_hex(data[2])) < 0){
+		return 2;
+	}
+
+	*ch  = (char)((hi << 4) | lo);
+	*out = 1;
+	return 3;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_number_digit
+*	功能:	累加一个十进制数字
+*	参数:	num: 数值转换状态  val: 数字  frac: 是否属于小数部分
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_number_digit(parse_number_t *num, unsigned int val, int frac)
+{
+	// 前导 0 不占用有效数字
+	if(0 == num->mant && 0 == val){
+		num->scale -= frac;
+		return ;
+	}
+
+	// 超出可精确累加的位数后只记录小数点的位移
+	if(num->digits < LIBSERIAL_PARSE_NUM_DIGITS){
+		num->mant = num->mant * 10 + val;
+		num->digits++;
+		num->scale -= frac;
+	}else{
+		num->inexact = 1;
+		num->scale += !frac;
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_number_feed
+*	功能:	向数值转换状态输入一个字符
+*	参数:	num: 数值转换状态  ch: 字符  pos: 字符相对片段起始的偏移
+*	返回:	无返回值
+*	备注:	语法为 [+-] (0x 十六进制数字 | 十进制数字 [. 十进制数字] [e [+-] 十进制数字])
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_number_feed(parse_number_t *num, char ch, unsigned int pos)
+{
+	unsigned int val = (unsigned int)(unsigned char)ch - '0';
+	int hex = 0x00;
+
+	switch(num->st){
+	case LIBSERIAL_PARSE_NUM_START:
+		if('-' == ch || '+' == ch){
+			num->neg = ('-' == ch);
+			num->st = LIBSERIAL_PARSE_NUM_SIGN;
+			return ;
+		}
+		// fall through
+	case LIBSERIAL_PARSE_NUM_SIGN:
+		if('0' == ch){
+			num->st = LIBSERIAL_PARSE_NUM_ZERO;
+			return ;
+		}
+		if(val < 10){
+			num->st = LIBSERIAL_PARSE_NUM_INT;
+			libserial_parse_number_digit(num, val, 0);
+			return ;
+		}
+		if('.' == ch){
+			num->st = LIBSERIAL_PARSE_NUM_DOT;
+			return ;
+		}
+		break;
+	case LIBSERIAL_PARSE_NUM_ZERO:
+		if('x' == (ch | 0x20)){
+			num->st = LIBSERIAL_PARSE_NUM_HEX;
+			return ;
+		}
+		// fall through
+	case LIBSERIAL_PARSE_NUM_INT:
+		if(val < 10){
+			num->st = LIBSERIAL_PARSE_NUM_INT;
+			libserial_parse_number_digit(num, val, 0);
+			return ;
+		}
+		if('.' == ch){
+			num->st = LIBSERIAL_PARSE_NUM_FRAC;
+			return ;
+		}
+		if('e' == (ch | 0x20)){
+			num->st = LIBSERIAL_PARSE_NUM_EXP;
+			return ;
+		}
+		break;
+	case LIBSERIAL_PARSE_NUM_DOT:
+	case LIBSERIAL_PARSE_NUM_FRAC:
+		if(val < 10){
+			num->st = LIBSERIAL_PARSE_NUM_FRAC;
+			libserial_parse_number_digit(num, val, 1);
+			return ;
+		}
+		if(LIBSERIAL_PARSE_NUM_FRAC == num->st && 'e' == (ch | 0x20)){
+			num->st = LIBSERIAL_PARSE_NUM_EXP;
+			return ;
+		}
+		break;
+	case LIBSERIAL_PARSE_NUM_EXP:
+		if('-' == ch || '+' == ch){
+			num->eneg = ('-' == ch);
+			num->st = LIBSERIAL_PARSE_NUM_ESIGN;
+			return ;
+		}
+		// fall through
+	case LIBSERIAL_PARSE_NUM_ESIGN:
+	case LIBSERIAL_PARSE_NUM_EDIG:
+		if(val < 10){
+			num->st = LIBSERIAL_PARSE_NUM_EDIG;
+			if(num->exp < 100000){
+				num->exp = num->exp * 10 + (int)val;
+			}
+			return ;
+		}
+		break;
+	case LIBSERIAL_PARSE_NUM_HEX:
+	case LIBSERIAL_PARSE_NUM_HDIG:
+		if((hex = libserial_parse_hex(ch)) >= 0){
+			num->st = LIBSERIAL_PARSE_NUM_HDIG;
+			num->inexact |= (unsigned char)!!(num->mant >> 60);
+			num->mant = (num->mant << 4) | (unsigned int)hex;
+			return ;
+		}
+		break;
+	default:
+		return ;
+	}
+
+	// 记录第一个非法字符的位置
+	num->st  = LIBSERIAL_PARSE_NUM_ERROR;
+	num->err = pos;
+	return ;
+}
 
-	// 预处理和大小写检查转换
-	libserial_parse_preprocess(obj, indata);
-	indata = libserial_parse_shift_convert(obj, indata);
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_number_float
+*	功能:	计算浮点数的值
+*	参数:	num: 数值转换状态  text: 数值文本  len: 数值文本长度
+*	返回:	浮点数的值(不含符号)
+*	备注:	有效数字和 10 的幂都能精确表示时直接计算, 否则交给 strtod() 以保证正确舍入;
+*			文本过长时按累加的有效数字近似计算
+*---------------------------------------------------------------------*/
+static double libserial_parse_number_float(const parse_number_t *num, const char *text, unsigned int len)
+{
+	static const double pow10[] = {
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+	int e = num->scale + (num->eneg ? -num->exp : num->exp);
+	double val = (double)num->mant;
+	char tmp[64] = {0x00};
 
-	// 拷贝数据
-	if(obj->buf.idx < obj->buf.space - 1){
-		obj->buf.buf[obj->buf.idx+1] = '\0';
-		obj->buf.buf[obj->buf.idx++] = indata;
-		obj->buf.len = obj->buf.idx;
+	if(0 == num->mant){
+		return 0.0;
 	}
-	
-	//长度检查
-	if(obj->buf.idx >= obj->buf.space - 1){
-		obj->buf.idx = 0;
-		obj->sta.dqu = 0;
-		return obj->buf.len;
+	if(!num->inexact && num->mant < (1ULL << 53) && e >= -22 && e <= 22){
+		return (e < 0) ? val / pow10[-e] : val * pow10[e];
 	}
-	
-	return 0;
+	if(len < sizeof(tmp)){
+		memcpy(tmp, text, len);
+		val = strtod(tmp, NULL);
+		return (val < 0) ? -val : val;
+	}
+	for(; e > 0 && val < 1e308; e--){
+		val *= 10.0;
+	}
+	for(; e < 0 && val > 0.0; e++){
+		val /= 10.0;
+	}
+	return val;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_number_end
+*	功能:	结束数值转换并输出结果
+*	参数:	num: 数值转换状态  text: 片段文本  begin: 数值相对片段起始的偏移  
+*			end: 数值结束位置相对片段起始的偏移  value: 返回转换结果
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_number_end(const parse_number_t *num, const char *text, unsigned int begin, unsigned int end, libserial_parse_value_t *value)
+{
+	unsigned long long limit = num->neg ? 0x8000000000000000ULL : 0x7FFFFFFFFFFFFFFFULL;
+
+	value->type = LIBSERIAL_PARSE_VALUE_TEXT;
+	value->err  = end;
+	value->i = 0x00;
+	value->f = 0.0;
+
+	switch(num->st){
+	case LIBSERIAL_PARSE_NUM_START:
+		value->type = LIBSERIAL_PARSE_VALUE_NONE;
+		value->err  = 0x00;
+		return ;
+	case LIBSERIAL_PARSE_NUM_ZERO:
+	case LIBSERIAL_PARSE_NUM_INT:
+	case LIBSERIAL_PARSE_NUM_HDIG:
+		// 超出 long long 范围(十六进制为超出 64 位)
+		if(num->inexact || (LIBSERIAL_PARSE_NUM_HDIG != num->st && num->mant > limit)){
+			value->err = begin;
+			return ;
+		}
+		value->type = (LIBSERIAL_PARSE_NUM_HDIG == num->st) ? LIBSERIAL_PARSE_VALUE_HEX : LIBSERIAL_PARSE_VALUE_DEC;
+		value->err  = 0x00;
+		value->i = (long long)(num->neg ? 0ULL - num->mant : num->mant);
+		value->f = num->neg ? -(double)num->mant : (double)num->mant;
+		return ;
+	case LIBSERIAL_PARSE_NUM_FRAC:
+	case LIBSERIAL_PARSE_NUM_EDIG:
+		value->type = LIBSERIAL_PARSE_VALUE_FLOAT;
+		value->err  = 0x00;
+		value->f = libserial_parse_number_float(num, text + begin, end - begin);
+		value->f = num->neg ? -value->f : value->f;
+		return ;
+	case LIBSERIAL_PARSE_NUM_ERROR:
+		value->err = num->err;
+		return ;
+	default:
+		// 数值不完整, 如只有正负号或缺少指数
+		return ;
+	}
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_field_end
+*	功能:	结束一个片段的数值转换并输出字段信息(片段位置除外)
+*	参数:	field: 字段信息  num: 数值转换状态  text: 片段文本  val: 值相对片段起始的偏移(0 表示没有 '=')
+*			end: 片段长度
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static void libserial_parse_field_end(libserial_parse_field_t *field, const parse_number_t *num, const char *text, unsigned int val, unsigned int end)
+{
+	if(0 == val){
+		memset(&field->key, 0x00, sizeof(field->key));
+	}
+	field->vofs = val;
+	libserial_parse_number_end(num, text, val, end, &field->value);
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_split
+*	功能:	按解析器配置原地拆分行文本, 可选在同一次扫描中转换每个片段的数值
+*	参数:	obj: 解析器对象  line: 行文本(原地改写)  size: 行文本长度
+*			argv: 返回片段信息(fields 为 NULL 时使用)  fields: 返回字段信息(可为 NULL)  argc: 最多可存储的片段个数
+*	返回:	拆分得到的片段个数
+*	备注:	fields 为常量 NULL 时数值转换的代码被编译器消除, 与只拆分片段的实现相同
+*---------------------------------------------------------------------*/
+static inline unsigned int libserial_parse_split(parse_object_t *obj, char *line, unsigned int size, libserial_parse_token_t *argv, libserial_parse_field_t *fields, unsigned int argc)
+{
+	unsigned int r = 0x00, w = 0x00, n = 0x00, k = 0x00, start = 0x00, val = 0x00, cnt = 0x00;
+	libserial_parse_token_t *tok = NULL;
+	parse_number_t num = {0x00};
+	const char *eq = NULL;
+	char dqu = 0x00, ch = 0x00;
+
+	while(r < size && cnt < argc){
+		// 快速路径: 片段中间批量处理不含特殊字符的数据(转换数值时在键值之间的第一个 '=' 处停下)
+		n = (w > start && w != val) ? libserial_parse_scan_stop(obj, line + r, size - r) : 0;
+		if(n > 0 && fields && 0 == val && (eq = (const char *)memchr(line + r, '=', n)) != NULL){
+			n = (unsigned int)(eq - (line + r));
+		}
+		if(n > 0){
+			if(LIBSERIAL_PARSE_SHIFT_NORMAL != obj->cfg.shift && !dqu){
+				libserial_parse_translate(obj, line + w, line + r, n);
+			}else if(w != r){
+				memmove(line + w, line + r, n);
+			}
+			for(k = 0; fields && k < n; k++){
+				libserial_parse_number_feed(&num, line[w + k], w + k - start);
+			}
+			w += n, r += n;
+			continue;
+		}
+
+		// 双引号内的转义序列, 解码得到的字符直接存储
+		ch = line[r++];
+		if(dqu && '\\' == ch && obj->cfg.escape){
+			r += libserial_parse_unescape(line + r, size - r, &ch, &n);
+			if(n){
+				if(fields){
+					libserial_parse_number_feed(&num, ch, w - start);
+				}
+				line[w++] = ch;
+			}
+			continue;
+		}
+
+		// 移除双引号、忽略字符、前置空格和 '=' 之后的空格
+		if('\"' == ch){
+			dqu = !dqu;
+			continue;
+		}
+		if(!dqu && LIBSERIAL_PARSE_MAP_TEST(obj->cfg.ignore, ch)){
+			continue;
+		}
+		if((w == start || w == val) && ' ' == ch){
+			continue;
+		}
+
+		// 匹配分隔符(双引号内的分隔字符不拆分片段), 记录片段
+		if(!dqu && LIBSERIAL_PARSE_MAP_TEST(obj->cfg.divide, ch)){
+			if(w > start){
+				if(fields){
+					libserial_parse_field_end(&fields[cnt], &num, line + start, val ? val - start : 0, w - start);
+				}
+				tok = fields ? &fields[cnt].tok : &argv[cnt];
+				tok->off = start;
+				tok->len = w - start;
+				tok->divide = ch;
+				line[w++] = '\0';
+				cnt++;
+			}
+			if(fields){
+				memset(&num, 0x00, sizeof(num));
+			}
+			start = w;
+			val = 0x00;
+			dqu = 0x00;
+			continue;
+		}
+
+		// 双引号外的第一个 '=' 结束键的转换
+		if(fields && !dqu && 0 == val && '=' == ch){
+			libserial_parse_number_end(&num, line + start, 0, w - start, &fields[cnt].key);
+			memset(&num, 0x00, sizeof(num));
+			line[w++] = ch;
+			val = w;
+			continue;
+		}
+
+		// 查表转换(双引号内的字符不进行转换)
+		ch = dqu ? ch : (char)obj->cfg.table[(unsigned char)ch];
+		if(fields){
+			libserial_parse_number_feed(&num, ch, w - start);
+		}
+		line[w++] = ch;
+	}
+
+	// 行结束时剩余的片段
+	if(w > start && cnt < argc){
+		if(fields){
+			libserial_parse_field_end(&fields[cnt], &num, line + start, val ? val - start : 0, w - start);
+		}
+		tok = fields ? &fields[cnt].tok : &argv[cnt];
+		tok->off = start;
+		tok->len = w - start;
+		tok->divide = '\0';
+		cnt++;
+	}
+	line[w] = '\0';
+
+	return cnt;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_tokenize
+*	功能:	按解析器的分隔、忽略和大小写配置, 一次性将一行文本原地拆分为多个片段
+*	参数:	splbuf: 提供配置的缓冲区  line: 行文本(原地改写)  size: 行文本长度
+*			argv: 返回片段信息  argc: argv 最多可存储的片段个数
+*	返回:	拆分得到的片段个数, 超出 argc 的部分被丢弃
+*	备注:	规则与逐字节调用 libserial_parse_text() 一致(空片段被跳过), 但双引号内的分隔字符不拆分片段;
+*			不影响缓冲区的解析状态, 每个片段在 line 内以 '\0' 结尾, line 至少需要 size + 1 字节可写空间
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_tokenize(libserial_parse_buf_t *spbuf, char *line, unsigned int size, libserial_parse_token_t *argv, unsigned int argc)
+{
+	return libserial_parse_split(get_parse_object(spbuf), line, size, argv, NULL, argc);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_tokenize_fields
+*	功能:	与 libserial_parse_tokenize() 相同地拆分行文本, 并在同一次扫描中将每个片段转换为数值或键值对
+*	参数:	splbuf: 提供配置的缓冲区  line: 行文本(原地改写)  size: 行文本长度
+*			fields: 返回字段信息  count: fields 最多可存储的字段个数
+*	返回:	拆分得到的字段个数, 超出 count 的部分被丢弃
+*	备注:	支持十进制整数、0x 前缀的十六进制整数和浮点数, 均可带正负号; 不申请内存, 不需要再次扫描片段;
+*			片段内双引号外的第一个 '=' 将片段分为键和值(需不在分隔字符集合内), '=' 之后的空格被跳过
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_tokenize_fields(libserial_parse_buf_t *spbuf, char *line, unsigned int size, libserial_parse_field_t *fields, unsigned int count)
+{
+	return libserial_parse_split(get_parse_object(spbuf), line, size, NULL, fields, count);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_convert
+*	功能:	将一个文本转换为数值或键值对, 用于逐字节、批量和回调接口得到的文本
+*	参数:	text: 文本(无需 '\0' 结尾)  len: 文本长度  field: 返回字段信息(tok.off 为 0, tok.divide 为 '\0')
+*	返回:	值的数值类型
+*	备注:	规则与 libserial_parse_tokenize_fields() 一致
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_convert(const char *text, unsigned int len, libserial_parse_field_t *field)
+{
+	parse_number_t num = {0x00};
+	unsigned int i = 0x00, val = 0x00;
+
+	for(i = 0; i < len; i++){
+		// 第一个 '=' 结束键的转换, 跳过其后的空格
+		if(0 == val && '=' == text[i]){
+			libserial_parse_number_end(&num, text, 0, i, &field->key);
+			memset(&num, 0x00, sizeof(num));
+			val = i + 1;
+			continue;
+		}
+		if(val > 0 && val == i && ' ' == text[i]){
+			val++;
+			continue;
+		}
+		libserial_parse_number_feed(&num, text[i], i);
+	}
+
+	field->tok.off = 0x00;
+	field->tok.len = len;
+	field->tok.divide = '\0';
+	libserial_parse_field_end(field, &num, text, val, len);
+
+	return field->value.type;
 }
 
 /*---------------------------------------------------------------------
@@ -334,8 +3087,416 @@ unsigned int libserial_parse_text_nl(libserial_parse_buf_t *spbuf, char indata)
 unsigned int libserial_parse_text_finish(libserial_parse_buf_t *spbuf)
 {
 	parse_object_t *obj = get_parse_object(spbuf);
+	libserial_parse_call_begin(obj);
+	LIBSERIAL_PARSE_STAT_BEGIN(obj);
+	LIBSERIAL_PARSE_STAT_ADD(obj, dqu_resets, 0 != obj->sta.dqu);
+	obj->sta.end = '\0';
+	obj->sta.ovf = obj->sta.full;
+	obj->sta.full = 0;
 	obj->buf.len = obj->buf.idx;
 	obj->buf.idx = 0;
 	obj->sta.dqu = 0;
+	obj->sta.esc = LIBSERIAL_PARSE_ESC_NONE;
+#ifdef LIBSERIAL_PARSE_FILTER
+	if(obj->flt.filter){
+		obj->buf.len = libserial_parse_filter_end(obj, obj->buf.len);
+	}
+#endif
+	LIBSERIAL_PARSE_STAT_END(obj, 0, obj->buf.len, 0);
+	LIBSERIAL_PARSE_INTERN_BLOCK(obj, obj->buf.buf, obj->buf.len);
+	libserial_parse_call_end(obj, obj->buf.len);
 	return obj->buf.len;
 }
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push_finish
+*	功能:	将仍在缓冲区的字符数据作为最后一个文本交给回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调
+*	返回:	0: 没有数据或回调返回 0  	其他: 回调返回的非 0 值
+*---------------------------------------------------------------------*/
+int libserial_parse_push_finish(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler)
+{
+	unsigned int len = libserial_parse_text_finish(spbuf);
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	return (len > 0) ? libserial_parse_emit(obj, handler, obj->buf.buf, len) : 0;
+}
+
+#ifdef LIBSERIAL_PARSE_IDLE
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_idle
+*	功能:	设置空闲超时时间
+*	参数:	splbuf: 缓冲区  timeout: 超时时间(单位与 libserial_parse_poll() 的 now 相同, 0 表示不启用)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_idle(libserial_parse_buf_t *spbuf, unsigned int timeout)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	obj->idle.timeout = timeout;
+	obj->idle.active  = 1;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_clock
+*	功能:	挂接时钟回调, 解析接口收到数据时通过它记录最后收到数据的时间
+*	参数:	splbuf: 缓冲区  clock: 时钟回调(NULL 代表解除挂接)  ctx: 回调参数
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_clock(libserial_parse_buf_t *spbuf, libserial_parse_clock_func_t clock, void *ctx)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	obj->idle.clock  = clock;
+	obj->idle.ctx    = ctx;
+	obj->idle.active = 1;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_poll
+*	功能:	检查空闲超时, 缓冲区中的不完整文本超时未收到后续数据时将其输出
+*	参数:	splbuf: 缓冲区  now: 当前时间(单位由使用者决定, 允许回绕)
+*	返回:	0: 未超时或没有不完整的文本  	>0: 输出的文本长度(同 libserial_parse_text_finish())
+*	备注:	未挂接时钟回调时解析接口只做标记, 其后第一次调用本函数时记录为最后收到数据的时间
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_poll(libserial_parse_buf_t *spbuf, unsigned int now)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	// 收到数据之后或没有不完整的文本时重新计时, 不改变解析状态
+	if(obj->idle.active || 0 == obj->buf.idx){
+		obj->idle.active = 0x00;
+		obj->idle.last   = now;
+		return 0;
+	}
+	if(0 == obj->idle.timeout || now - obj->idle.last < obj->idle.timeout){
+		return 0;
+	}
+	return libserial_parse_text_finish(spbuf);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push_poll
+*	功能:	检查空闲超时, 超时则将不完整的文本交给回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调  now: 当前时间
+*	返回:	0: 未超时、没有数据或回调返回 0  	其他: 回调返回的非 0 值
+*---------------------------------------------------------------------*/
+int libserial_parse_push_poll(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler, unsigned int now)
+{
+	unsigned int len = libserial_parse_poll(spbuf, now);
+	parse_object_t *obj = get_parse_object(spbuf);
+
+	return (len > 0) ? libserial_parse_emit(obj, handler, obj->buf.buf, len) : 0;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_idle
+*	功能:	获取距离空闲超时还需等待的时间
+*	参数:	splbuf: 缓冲区  now: 当前时间
+*	返回:	0: 未启用或没有不完整的文本  	>0: 还需等待的时间(已超时返回 1)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_get_idle(libserial_parse_buf_t *spbuf, unsigned int now)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	unsigned int elapsed;
+
+	if(0 == obj->idle.timeout || 0 == obj->buf.idx){
+		return 0;
+	}
+	if(obj->idle.active){
+		return obj->idle.timeout;
+	}
+	elapsed = now - obj->idle.last;
+	return (elapsed < obj->idle.timeout) ? obj->idle.timeout - elapsed : 1;
+}
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	get_pool_object
+*	功能:	从用户提供的内存中获取多通道解析器池对象的位置
+*	参数:	pool: 多通道解析器池
+*	返回:	多通道解析器池对象(按指针大小对齐)
+*---------------------------------------------------------------------*/
+static inline parse_pool_t *get_pool_object(libserial_parse_pool_t *pool)
+{
+	size_t addr = (size_t)pool->buf;
+	return (parse_pool_t *)((addr + LIBSERIAL_PARSE_POOL_ALIGN - 1) & ~(size_t)(LIBSERIAL_PARSE_POOL_ALIGN - 1));
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_load
+*	功能:	将指定通道的状态装入池内的解析器对象
+*	参数:	pobj: 多通道解析器池对象	channel: 通道号
+*	返回:	装入状态后的解析器对象
+*---------------------------------------------------------------------*/
+static inline parse_object_t *libserial_parse_pool_load(parse_pool_t *pobj, unsigned int channel)
+{
+	parse_object_t *obj = &pobj->obj;
+	obj->buf.buf = pobj->text + (size_t)channel * obj->buf.space;
+	obj->buf.idx = pobj->idx[channel];
+	obj->buf.len = pobj->len[channel];
+	obj->sta.dqu = pobj->sta[channel] & 0x01;
+	obj->sta.ovf = (pobj->sta[channel] >> 1) & 0x01;
+	obj->sta.esc = (pobj->sta[channel] >> 2) & 0x03;
+	obj->sta.hex = (pobj->sta[channel] >> 4) & 0x0f;
+	obj->sta.end = pobj->end[channel];
+	return obj;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_save
+*	功能:	将池内解析器对象的状态写回指定通道
+*	参数:	pobj: 多通道解析器池对象	channel: 通道号
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+static inline void libserial_parse_pool_save(parse_pool_t *pobj, unsigned int channel)
+{
+	pobj->idx[channel] = pobj->obj.buf.idx;
+	pobj->len[channel] = pobj->obj.buf.len;
+	pobj->sta[channel] = (char)((0 != pobj->obj.sta.dqu) | (pobj->obj.sta.ovf << 1) | (pobj->obj.sta.esc << 2) | (pobj->obj.sta.hex << 4));
+	pobj->end[channel] = pobj->obj.sta.end;
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_size
+*	功能:	计算多通道解析器池需要的内存大小(包含内部数据结构所用空间)
+*	参数:	channels: 通道个数  size: 每个通道可用缓冲区大小
+*	返回:	需要的内存字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_size(unsigned int channels, unsigned int size)
+{
+	return LIBSERIAL_PARSE_POOL_ALIGN - 1 + sizeof(parse_pool_t) + channels * (2 * sizeof(unsigned int) + 2 + size);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_create
+*	功能:	使用接口内部申请多通道解析器池, 所有通道共用一块连续内存
+*	参数:	channels: 通道个数  size: 每个通道可用缓冲区大小
+*	返回:	NULL: 申请内存空间失败		>0: 申请成功
+*---------------------------------------------------------------------*/
+libserial_parse_pool_t *libserial_parse_pool_create(unsigned int channels, unsigned int size)
+{
+	libserial_parse_pool_t *pool = NULL;
+
+	if(0 == channels || 0 == size){
+		return NULL;
+	}
+	if((pool = (libserial_parse_pool_t *)malloc(sizeof(libserial_parse_pool_t))) == NULL){
+		return NULL;
+	}
+
+	pool->channels = channels;
+	pool->total = libserial_parse_pool_size(channels, size);
+	if((pool->buf = (char *)malloc(pool->total)) == NULL){
+		free(pool);
+		return NULL;
+	}
+
+	return pool;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_release
+*	功能:	释放接口内部申请的多通道解析器池
+*	参数:	pool: 由 libserial_parse_pool_create() 创建的多通道解析器池
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_release(libserial_parse_pool_t *pool)
+{
+	if (pool) {
+		pool->total = 0;
+		free(pool->buf);
+		free(pool);
+	}
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_init
+*	功能:	使用用户提供的或创建接口的内存, 初始化多通道解析器池
+*	参数:	pool: 多通道解析器池
+*	返回:	0: 不满足最小长度要求  >0: 每个通道可存储最长文本的长度 
+*	备注:	默认配置与 libserial_parse_init() 相同, 所有通道共用同一份配置
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_init(libserial_parse_pool_t *pool)
+{
+	parse_pool_t *pobj = get_pool_object(pool);
+	unsigned int head = LIBSERIAL_PARSE_POOL_ALIGN - 1 + sizeof(parse_pool_t);
+	unsigned int state = pool->channels * (2 * sizeof(unsigned int) + 2);
+
+	if(0 == pool->channels || pool->total < head + state + pool->channels * 1){
+		return 0;
+	}
+	memset(pool->buf, 0x00, pool->total);
+
+	// 状态数组在前, 文本缓冲区在后
+	pobj->channels	= pool->channels;
+	pobj->idx		= (unsigned int *)(pobj + 1);
+	pobj->len		= pobj->idx + pool->channels;
+	pobj->sta		= (char *)(pobj->len + pool->channels);
+	pobj->end		= pobj->sta + pool->channels;
+	pobj->text		= pobj->end + pool->channels;
+	libserial_parse_object_init(&pobj->obj, pobj->text, (pool->total - head - state) / pool->channels);
+
+	return pobj->obj.buf.space;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_set_config
+*	功能:	将解析器的分隔、忽略、大小写转换和转义配置应用到所有通道
+*	参数:	pool: 多通道解析器池  spbuf: 已配置好的解析器缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_set_config(libserial_parse_pool_t *pool, libserial_parse_buf_t *spbuf)
+{
+	get_pool_object(pool)->obj.cfg = get_parse_object(spbuf)->cfg;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_text
+*	功能:	获取指定通道的文本缓冲区
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	通道的文本缓冲区, 解析完成后的文本以 '\0' 结尾
+*---------------------------------------------------------------------*/
+char *libserial_parse_pool_text(libserial_parse_pool_t *pool, unsigned int channel)
+{
+	parse_pool_t *pobj = get_pool_object(pool);
+	return pobj->text + (size_t)channel * pobj->obj.buf.space;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_reset
+*	功能:	重置指定通道的解析状态
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_reset(libserial_parse_pool_t *pool, unsigned int channel)
+{
+	parse_pool_t *pobj = get_pool_object(pool);
+	LIBSERIAL_PARSE_STAT_BEGIN(&pobj->obj);
+	LIBSERIAL_PARSE_STAT_ADD(&pobj->obj, dqu_resets, 0 != (pobj->sta[channel] & 0x01));
+	pobj->idx[channel] = 0x00;
+	pobj->len[channel] = 0x00;
+	pobj->sta[channel] = 0x00;
+	pobj->end[channel] = 0x00;
+	libserial_parse_pool_text(pool, channel)[0] = '\0';
+	LIBSERIAL_PARSE_STAT_END(&pobj->obj, 0, 0, 0);
+	return ;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_get_status
+*	功能:	获取指定通道上一个文本的完整状态
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	LIBSERIAL_PARSE_STATUS_OK: 文本完整  LIBSERIAL_PARSE_STATUS_OVERFLOW: 文本因缓冲区已满被截断
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_get_status(libserial_parse_pool_t *pool, unsigned int channel)
+{
+	return (get_pool_object(pool)->sta[channel] & 0x02) ? LIBSERIAL_PARSE_STATUS_OVERFLOW : LIBSERIAL_PARSE_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_feed
+*	功能:	批量解析指定通道以指定符号分隔或跳过的文本, 遇到完整文本即停止
+*	参数:	pool: 多通道解析器池  channel: 通道号  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+*	备注:	与 libserial_parse_feed() 行为一致, 文本通过 libserial_parse_pool_text() 获取
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_feed(libserial_parse_pool_t *pool, unsigned int channel, const char *data, unsigned int size, unsigned int *used)
+{
+	parse_pool_t *pobj = get_pool_object(pool);
+	unsigned int n = 0x00, len = 0x00;
+
+	LIBSERIAL_PARSE_STAT_BEGIN(&pobj->obj);
+	len = libserial_parse_feed_block(libserial_parse_pool_load(pobj, channel), data, size, &n);
+	libserial_parse_pool_save(pobj, channel);
+	LIBSERIAL_PARSE_STAT_END(&pobj->obj, n, len, 1);
+	if(used){
+		*used = n;
+	}
+
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_feed_nl  (nl -> new line)
+*	功能:	批量解析指定通道以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 遇到完整文本即停止
+*	参数:	pool: 多通道解析器池  channel: 通道号  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+*	备注:	与 libserial_parse_feed_nl() 行为一致, 文本通过 libserial_parse_pool_text() 获取
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_feed_nl(libserial_parse_pool_t *pool, unsigned int channel, const char *data, unsigned int size, unsigned int *used)
+{
+	parse_pool_t *pobj = get_pool_object(pool);
+	unsigned int n = 0x00, len = 0x00;
+
+	LIBSERIAL_PARSE_STAT_BEGIN(&pobj->obj);
+	len = libserial_parse_feed_nl_block(libserial_parse_pool_load(pobj, channel), data, size, &n);
+	libserial_parse_pool_save(pobj, channel);
+	LIBSERIAL_PARSE_STAT_END(&pobj->obj, n, len, 1);
+	if(used){
+		*used = n;
+	}
+
+	return len;
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_finish
+*	功能:	获取指定通道当前仍在缓冲区的字符数据
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	0: 没有数据  	>0:剩余字符串长度(不包含 '\0')
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_finish(libserial_parse_pool_t *pool, unsigned int channel)
+{
+	parse_pool_t *pobj = get_pool_object(pool);
+	LIBSERIAL_PARSE_STAT_BEGIN(&pobj->obj);
+	LIBSERIAL_PARSE_STAT_ADD(&pobj->obj, dqu_resets, 0 != (pobj->sta[channel] & 0x01));
+	pobj->len[channel] = pobj->idx[channel];
+	pobj->idx[channel] = 0x00;
+	pobj->sta[channel] = 0x00;
+	pobj->end[channel] = '\0';
+	LIBSERIAL_PARSE_STAT_END(&pobj->obj, 0, pobj->len[channel], 0);
+	return pobj->len[channel];
+}
+
+#ifdef LIBSERIAL_PARSE_STATS
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_stats
+*	功能:	获取解析器的运行统计快照
+*	参数:	splbuf: 缓冲区  stats: 返回运行统计
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_get_stats(libserial_parse_buf_t *spbuf, libserial_parse_stats_t *stats)
+{
+	libserial_parse_stats_snapshot(get_parse_object(spbuf), stats);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_clear_stats
+*	功能:	清除解析器的运行统计
+*	参数:	splbuf: 缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_clear_stats(libserial_parse_buf_t *spbuf)
+{
+	parse_object_t *obj = get_parse_object(spbuf);
+	libserial_parse_stats_begin(obj);
+	memset(&get_parse_stats(obj)->data, 0x00, sizeof(libserial_parse_stats_t));
+	libserial_parse_stats_end(obj, 0, 0, 0);
+}
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_get_stats
+*	功能:	获取多通道解析器池所有通道合计的运行统计快照
+*	参数:	pool: 多通道解析器池  stats: 返回运行统计
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_get_stats(libserial_parse_pool_t *pool, libserial_parse_stats_t *stats)
+{
+	libserial_parse_stats_snapshot(&get_pool_object(pool)->obj, stats);
+}
+#endif
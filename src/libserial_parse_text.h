@@ -17,14 +17,207 @@ extern "C" {
 #endif
 
 // 缓存大小包含了接口内部所使用的数据结构空间
+// 定义 LIBSERIAL_PARSE_ALIGNED 时(库与使用者需使用相同定义), 内部数据结构自然对齐并按缓存行存放,
+// 其地址由 libserial_parse_init() 记录在 obj 中, 解析时无需每次根据缓存地址重新计算
+// 定义 LIBSERIAL_PARSE_GROW 时(库与使用者需使用相同定义), 可通过 libserial_parse_set_grow() 启用缓冲区自动增长
+// 定义 LIBSERIAL_PARSE_TOKENS 时(库与使用者需使用相同定义), 可通过 libserial_parse_set_token_arena() 挂接文本收集区
+// 定义 LIBSERIAL_PARSE_FILTER 时(库与使用者需使用相同定义), 可通过 libserial_parse_set_filter() 挂接行过滤器
+// 定义 LIBSERIAL_PARSE_IDLE 时(库与使用者需使用相同定义), 可通过 libserial_parse_set_idle() 设置空闲超时
+// 定义 LIBSERIAL_PARSE_INTERN 时(库与使用者需使用相同定义), 可通过 libserial_parse_set_intern() 挂接行驻留缓存
 typedef struct{
 	char *buf;					// 缓存地址, 用于存储解析后的字符串
 	unsigned int total;			// 缓存大小, 标明该内存空间的总长度
+#if defined(LIBSERIAL_PARSE_ALIGNED) || defined(LIBSERIAL_PARSE_GROW)
+	void *obj;					// 内部数据结构地址, 由 libserial_parse_init() 设置
+#endif
 }libserial_parse_buf_t;
 
+// 多通道解析器池, 缓存大小包含了接口内部所使用的数据结构空间
+typedef struct{
+	char *buf;					// 缓存地址, 存储所有通道的解析状态和文本
+	unsigned int total;			// 缓存大小, 标明该内存空间的总长度
+	unsigned int channels;		// 通道个数
+}libserial_parse_pool_t;
+
+// 文本位置描述, 用于零拷贝方式返回文本
+typedef struct{
+	const char *ptr;			// 文本地址, 指向用户输入的数据块或内部缓冲区
+	unsigned int len;			// 文本长度
+}libserial_parse_span_t;
+
+// 文本回调, ptr 指向文本(回调返回后失效, 不一定以 '\0' 结尾), delimiter 为结束文本的分隔字符(被截断或结束时为 '\0')
+// 返回非 0 值停止解析
+typedef int (*libserial_parse_token_func_t)(void *ctx, const char *ptr, unsigned int len, char delimiter);
+
+// 事件回调, 用于 libserial_parse_push() 系列接口
+typedef struct{
+	libserial_parse_token_func_t on_token;		// 完整文本回调
+	libserial_parse_token_func_t on_overflow;	// 因缓冲区已满被截断的文本回调(可为 NULL, 此时交给 on_token)
+	void *ctx;									// 用户上下文, 作为回调的第一个参数
+}libserial_parse_handler_t;
+
+// 时钟回调, 返回当前时间(单位与 libserial_parse_poll() 的 now 相同), 用于记录最后收到数据的时间
+typedef unsigned int (*libserial_parse_clock_func_t)(void *ctx);
+
+// 片段描述, 用于返回命令行分词结果
+typedef struct{
+	unsigned int off;			// 片段在行文本内的偏移
+	unsigned int len;			// 片段长度
+	char divide;				// 结束该片段的分隔字符, 行结束为 '\0'
+}libserial_parse_token_t;
+
+#define LIBSERIAL_PARSE_VALUE_NONE			0		// 空文本
+#define LIBSERIAL_PARSE_VALUE_TEXT			1		// 不是数值或超出范围, err 指明第一个非法字符的位置
+#define LIBSERIAL_PARSE_VALUE_DEC			2		// 十进制整数
+#define LIBSERIAL_PARSE_VALUE_HEX			3		// 十六进制整数(0x 前缀, 最多 64 位)
+#define LIBSERIAL_PARSE_VALUE_FLOAT			4		// 浮点数(包含小数点或指数)
+
+// 数值转换结果, 整数同时填写 i 和 f, 浮点数只填写 f
+typedef struct{
+	unsigned char type;			// 数值类型
+	unsigned int err;			// 类型为 TEXT 时第一个非法字符相对片段起始的偏移(超出范围时为数值的起始位置)
+	long long i;				// 整数值
+	double f;					// 浮点值
+}libserial_parse_value_t;
+
+// 字段描述, 用于返回分词并转换数值的结果
+typedef struct{
+	libserial_parse_token_t tok;	// 片段信息, 与 libserial_parse_tokenize() 的输出相同
+	unsigned int vofs;				// 值相对片段起始的偏移, 片段不包含 '=' 时为 0
+	libserial_parse_value_t key;	// 第一个 '=' 之前的键, 片段不包含 '=' 时类型为 NONE
+	libserial_parse_value_t value;	// 值(片段不包含 '=' 时为整个片段)
+}libserial_parse_field_t;
+
+// 文本收集区, 挂接到解析器后文本直接解析到存储区的空闲位置并依次保留, 用于一次性获取一帧数据的全部文本
+// 存储区和片段数组由用户提供, 每个文本在存储区内以 '\0' 结尾, argv[i].off 为相对 buf 的偏移
+typedef struct{
+	char *buf;							// 存储区地址
+	unsigned int total;					// 存储区大小
+	libserial_parse_token_t *argv;		// 片段数组
+	unsigned int argc;					// 片段数组可存储的片段个数
+	unsigned int count;					// 已收集的文本个数
+	unsigned int used;					// 存储区已使用的字节数
+	unsigned int dropped;				// 因存储区或片段数组已满未能收集的文本个数
+}libserial_parse_token_arena_t;
+
+// 行过滤关键字
+typedef struct{
+	const char *text;			// 关键字(不能为空串或只有 '\r', 不能包含 '\n')
+	char prefix;				// 0: 匹配行内任意位置  1: 只匹配行首
+}libserial_parse_pattern_t;
+
+// 行过滤器, 由 libserial_parse_filter_build() 将一组关键字编译为 Aho-Corasick 自动机
+// 各表位于用户提供的存储区内, 过滤器挂接期间存储区需保持有效, 可同时挂接到多个解析器
+typedef struct{
+	unsigned int *next;			// 状态转移表, 每个状态 classes 项, 为目标状态在表内的偏移
+	unsigned int *out;			// 各状态的匹配结果, 低 16 位为行内匹配的关键字编号 + 1, 高 16 位为行首匹配的关键字编号 + 1
+	unsigned short *depth;		// 各状态对应的关键字前缀长度
+	unsigned int states;		// 状态个数
+	unsigned int classes;		// 字符类别个数(关键字中出现的字符各为一类, 其余字符为第 0 类)
+	unsigned int match;			// 有匹配结果的状态在表内的起始偏移(这些状态排在最后)
+	unsigned char cls[256];		// 字符到类别的映射
+	char skip[8];				// 初始状态下需要停下的字符(换行符和行内关键字的首字符)
+	unsigned char nskip;		// skip 中的字符个数, 0 表示字符过多, 不做批量跳过
+}libserial_parse_filter_t;
+
+// 行驻留缓存每组的槽位个数
+#define LIBSERIAL_PARSE_INTERN_WAYS			4
+
+// 行驻留缓存槽位
+typedef struct{
+	unsigned int hash;			// 文本哈希值
+	unsigned int len;			// 文本长度 + 1 (0 表示空槽位)
+	unsigned int stamp;			// 最近一次命中或驻留时的使用序号
+}libserial_parse_intern_slot_t;
+
+// 行驻留缓存, 由 libserial_parse_intern_init() 在用户提供的存储区内建立
+// 文本按哈希值选组, 组内按最近最少使用淘汰, 槽位编号即驻留编号; 可同时挂接到同一线程内的多个解析器
+typedef struct{
+	libserial_parse_intern_slot_t *slot;	// 槽位信息
+	char *text;					// 槽位文本, 每个槽位 width 字节
+	unsigned int slots;			// 槽位个数
+	unsigned int width;			// 可驻留文本的最大长度
+	unsigned int mask;			// 组号掩码(组数为 2 的幂)
+	unsigned int clock;			// 使用序号
+	unsigned long long hits;		// 命中次数
+	unsigned long long misses;		// 未命中(新驻留)次数
+	unsigned long long evictions;	// 淘汰其他文本的次数
+}libserial_parse_intern_t;
+
 #define LIBSERIAL_PARSE_SHIFT_NORMAL		0		// 不转换
 #define LIBSERIAL_PARSE_SHIFT_LOWER 		1		// 转换为小写字母
 #define LIBSERIAL_PARSE_SHIFT_UPPER 		2		// 转换为大写字母
+#define LIBSERIAL_PARSE_SHIFT_TABLE 		3		// 使用用户提供的转换表
+
+#define LIBSERIAL_PARSE_STATUS_OK			0		// 文本完整
+#define LIBSERIAL_PARSE_STATUS_OVERFLOW		1		// 文本因缓冲区已满被截断
+
+// 定义 LIBSERIAL_PARSE_STATS 启用运行统计(库与使用者需使用相同定义), 默认不编译
+#ifdef LIBSERIAL_PARSE_STATS
+#define LIBSERIAL_PARSE_STATS_LEN_BINS		16		// 文本长度直方图区间个数
+#define LIBSERIAL_PARSE_STATS_CYCLE_BINS	32		// 批量接口耗费周期直方图区间个数
+
+// 运行统计, 直方图第 n 项统计数值在 [2^n, 2^(n+1)) 区间的次数(第 0 项包含 0), 超出范围计入最后一项
+typedef struct{
+	unsigned long long bytes;		// 输入字节数
+	unsigned long long tokens;		// 输出文本个数
+	unsigned long long ignored;		// 被忽略的字节数(忽略字符和前置空格)
+	unsigned long long overflows;	// 因缓冲区满而提前结束的文本个数
+	unsigned long long dqu_resets;	// 双引号未闭合即被重置的次数
+	unsigned long long filtered;	// 被行过滤器丢弃的文本个数
+	unsigned long long feeds;		// 批量接口调用次数
+	unsigned int len_hist[LIBSERIAL_PARSE_STATS_LEN_BINS];		// 文本长度直方图
+	unsigned int cycle_hist[LIBSERIAL_PARSE_STATS_CYCLE_BINS];	// 批量接口每次调用耗费周期直方图
+}libserial_parse_stats_t;
+#endif
+
+// 定义 LIBSERIAL_PARSE_ALIGNED 时解析器对象的对齐字节数(库与使用者需使用相同定义)
+#if defined(LIBSERIAL_PARSE_ALIGNED) && !defined(LIBSERIAL_PARSE_ALIGN)
+#define LIBSERIAL_PARSE_ALIGN				64
+#endif
+
+// 内部数据结构所用空间的编译期上限(不小于 libserial_parse_internal_size()), 随启用的编译宏增加,
+// 静态缓存可定义为 char buff[N + LIBSERIAL_PARSE_INTERNAL_MAX], 保证在任意选项组合下仍有 N 字节可用
+#define LIBSERIAL_PARSE_INTERNAL_BASE		(2 * sizeof(void *) + 112)
+#ifdef LIBSERIAL_PARSE_TOKENS
+#define LIBSERIAL_PARSE_INTERNAL_TOKENS		(sizeof(void *) + 8)
+#else
+#define LIBSERIAL_PARSE_INTERNAL_TOKENS		0
+#endif
+#ifdef LIBSERIAL_PARSE_FILTER
+#define LIBSERIAL_PARSE_INTERNAL_FILTER		(sizeof(void *) + 16)
+#else
+#define LIBSERIAL_PARSE_INTERNAL_FILTER		0
+#endif
+#ifdef LIBSERIAL_PARSE_INTERN
+#define LIBSERIAL_PARSE_INTERNAL_INTERN		(sizeof(void *) + 24)
+#else
+#define LIBSERIAL_PARSE_INTERNAL_INTERN		0
+#endif
+#ifdef LIBSERIAL_PARSE_IDLE
+#define LIBSERIAL_PARSE_INTERNAL_IDLE		(2 * sizeof(void *) + 16)
+#else
+#define LIBSERIAL_PARSE_INTERNAL_IDLE		0
+#endif
+#ifdef LIBSERIAL_PARSE_GROW
+#define LIBSERIAL_PARSE_INTERNAL_GROW		(2 * sizeof(void *) + 16)
+#else
+#define LIBSERIAL_PARSE_INTERNAL_GROW		0
+#endif
+#ifdef LIBSERIAL_PARSE_STATS
+#define LIBSERIAL_PARSE_INTERNAL_STATS		(sizeof(libserial_parse_stats_t) + 24)
+#else
+#define LIBSERIAL_PARSE_INTERNAL_STATS		0
+#endif
+#ifdef LIBSERIAL_PARSE_ALIGNED
+#define LIBSERIAL_PARSE_INTERNAL_ALIGN		(LIBSERIAL_PARSE_ALIGN + 8)
+#else
+#define LIBSERIAL_PARSE_INTERNAL_ALIGN		0
+#endif
+#define LIBSERIAL_PARSE_INTERNAL_MAX		(LIBSERIAL_PARSE_INTERNAL_BASE + LIBSERIAL_PARSE_INTERNAL_TOKENS + \
+											 LIBSERIAL_PARSE_INTERNAL_FILTER + LIBSERIAL_PARSE_INTERNAL_INTERN + \
+											 LIBSERIAL_PARSE_INTERNAL_IDLE + LIBSERIAL_PARSE_INTERNAL_GROW + \
+											 LIBSERIAL_PARSE_INTERNAL_STATS + LIBSERIAL_PARSE_INTERNAL_ALIGN)
 
 /*---------------------------------------------------------------------
 *	函数: 	libserial_parse_create
@@ -85,6 +278,188 @@ void libserial_parse_set_divide(libserial_parse_buf_t *spbuf, char divide);
 *---------------------------------------------------------------------*/
 void libserial_parse_set_ignore(libserial_parse_buf_t *spbuf, char ignore);
 
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_divide_set
+*	功能:	设定分隔字符集合, 集合内任意字符都可以结束文本
+*	参数:	splbuf: 缓冲区  set: 分隔字符组成的字符串, 如 " ,=\t" (NULL 或 "" 代表不分隔)
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_set_divide_set(libserial_parse_buf_t *spbuf, const char *set);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_ignore_set
+*	功能:	设定忽略字符集合, 集合内任意字符都会被忽略
+*	参数:	splbuf: 缓冲区  set: 忽略字符组成的字符串, 如 " \t" (NULL 或 "" 代表不忽略任何字符)
+*	返回:	无返回值
+*	备注:	双引号内的字符不会受此限制
+*---------------------------------------------------------------------*/
+void libserial_parse_set_ignore_set(libserial_parse_buf_t *spbuf, const char *set);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_divide
+*	功能:	获取结束上一个文本的分隔字符
+*	参数:	splbuf: 缓冲区
+*	返回:	分隔字符, 因缓冲区满或 libserial_parse_text_finish() 结束的文本返回 '\0'
+*---------------------------------------------------------------------*/
+char libserial_parse_get_divide(libserial_parse_buf_t *spbuf);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_status
+*	功能:	获取上一个文本的完整状态
+*	参数:	splbuf: 缓冲区
+*	返回:	LIBSERIAL_PARSE_STATUS_OK: 文本完整  LIBSERIAL_PARSE_STATUS_OVERFLOW: 文本因缓冲区已满被截断
+*	备注:	固定大小的缓冲区被截断后, 该行剩余数据作为下一个文本继续解析;
+*			可增长的缓冲区达到上限后丢弃剩余数据直至分隔字符, 被截断的文本在分隔字符处返回
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_get_status(libserial_parse_buf_t *spbuf);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_text
+*	功能:	获取上一个文本的地址
+*	参数:	splbuf: 缓冲区
+*	返回:	以 '\0' 结尾的文本, 通常为 spbuf->buf, 挂接文本收集区时位于收集区内
+*	备注:	在下一次调用解析接口之前有效; 零拷贝接口直接引用输入数据的文本以 span 为准
+*---------------------------------------------------------------------*/
+const char *libserial_parse_get_text(libserial_parse_buf_t *spbuf);
+
+#ifdef LIBSERIAL_PARSE_GROW
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_grow
+*	功能:	启用缓冲区自动增长, 文本超出缓冲区时按倍数扩大缓冲区直至上限
+*	参数:	splbuf: 由 libserial_parse_create() 创建并已初始化的缓冲区  limit: 缓冲区增长上限
+*	返回:	0: 内存不足、上限小于当前缓冲区大小或已挂接文本收集区、行过滤器  >0: 当前可存储最长文本的长度
+*	备注:	启用后内部数据结构移出 spbuf->buf, spbuf->buf 和 spbuf->total 会随增长、收缩改变, 解析完成后需重新读取;
+*			连续多个较短的文本之后缓冲区逐步收缩, 最小为启用时的大小; 不可再次调用 libserial_parse_init()
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_set_grow(libserial_parse_buf_t *spbuf, unsigned int limit);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_grow
+*	功能:	获取缓冲区增长上限
+*	参数:	splbuf: 缓冲区
+*	返回:	0: 未启用自动增长  >0: 缓冲区增长上限
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_get_grow(libserial_parse_buf_t *spbuf);
+#endif
+
+#ifdef LIBSERIAL_PARSE_TOKENS
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_token_arena
+*	功能:	挂接文本收集区, 此后的文本直接解析到收集区内并被依次保留
+*	参数:	splbuf: 缓冲区  arena: 已重置的文本收集区(NULL 代表解除挂接, 恢复使用 spbuf->buf)
+*	返回:	0: 收集区空间不足或缓冲区已启用自动增长  >0: 当前可存储最长文本的长度
+*	备注:	挂接期间文本位于收集区而非 spbuf->buf(可通过 libserial_parse_get_text() 获取), 零拷贝接口也返回收集区内的地址;
+*			可存储最长文本的长度随收集区剩余空间减少, 收集区满后的文本仍正常返回但不再保留(计入 dropped);
+*			一帧处理完毕后调用 libserial_parse_token_arena_reset() 重新收集, 未完成的文本会被移到收集区起始位置
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_set_token_arena(libserial_parse_buf_t *spbuf, libserial_parse_token_arena_t *arena);
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_token_arena_reset
+*	功能:	清空文本收集区, 时间复杂度 O(1)
+*	参数:	arena: 文本收集区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_token_arena_reset(libserial_parse_token_arena_t *arena);
+
+#ifdef LIBSERIAL_PARSE_FILTER
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_size
+*	功能:	计算编译行过滤器所需的存储区大小
+*	参数:	patterns: 关键字数组  count: 关键字个数
+*	返回:	0: 关键字不合法或状态数超出 65535  >0: 存储区字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_filter_size(const libserial_parse_pattern_t *patterns, unsigned int count);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_filter_build
+*	功能:	将一组关键字编译为行过滤器
+*	参数:	filter: 行过滤器  patterns: 关键字数组  count: 关键字个数  
+*			mem: 存储区  size: 存储区大小(不小于 libserial_parse_filter_size())
+*	返回:	0: 关键字不合法或存储区不足  >0: 自动机状态个数
+*	备注:	关键字编号即其在数组中的下标; 编译完成后不再访问 patterns
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_filter_build(libserial_parse_filter_t *filter, const libserial_parse_pattern_t *patterns, unsigned int count, void *mem, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_filter
+*	功能:	挂接行过滤器, 此后以换行符为终止符的接口只返回包含任一关键字的文本
+*	参数:	splbuf: 缓冲区  filter: 已编译的行过滤器(NULL 代表解除挂接)
+*	返回:	0: 缓冲区已启用自动增长  >0: 可存储最长文本的长度
+*	备注:	只作用于 *_nl 系列接口及其后的 libserial_parse_text_finish(), 按输入的原始字节(包含行尾 '\r')匹配;
+*			因缓冲区满被截断的文本分别匹配; 批量接口在确认匹配之前只运行自动机, 
+*			完整位于数据块内且不匹配的文本不会被拷贝, 跨越数据块的部分仍需缓存;
+*			不匹配的文本计入运行统计的 filtered, 不计入 tokens
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_set_filter(libserial_parse_buf_t *spbuf, const libserial_parse_filter_t *filter);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_match
+*	功能:	获取上一个返回的文本匹配到的关键字编号
+*	参数:	splbuf: 缓冲区
+*	返回:	-1: 未挂接行过滤器或尚未返回文本  >=0: 关键字编号, 多个关键字匹配时为最先结束的一个(同时结束取编号最小者)
+*---------------------------------------------------------------------*/
+int libserial_parse_get_match(libserial_parse_buf_t *spbuf);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_filter
+*	功能:	获取挂接的行过滤器
+*	参数:	splbuf: 缓冲区
+*	返回:	NULL: 未挂接行过滤器  其他: 行过滤器
+*---------------------------------------------------------------------*/
+const libserial_parse_filter_t *libserial_parse_get_filter(libserial_parse_buf_t *spbuf);
+#endif
+
+#ifdef LIBSERIAL_PARSE_INTERN
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_intern_size
+*	功能:	计算行驻留缓存所需的存储区大小
+*	参数:	slots: 槽位个数(不少于 LIBSERIAL_PARSE_INTERN_WAYS)  width: 可驻留文本的最大长度
+*	返回:	0: 参数不合法或超出 4GB  >0: 存储区字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_intern_size(unsigned int slots, unsigned int width);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_intern_init
+*	功能:	在存储区内建立(或清空)行驻留缓存
+*	参数:	cache: 行驻留缓存  slots: 槽位个数  width: 可驻留文本的最大长度
+*			mem: 存储区  size: 存储区大小(不小于 libserial_parse_intern_size())
+*	返回:	0: 参数不合法或存储区不足  >0: 实际槽位个数
+*	备注:	槽位个数向下取整为 LIBSERIAL_PARSE_INTERN_WAYS 乘以 2 的幂
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_intern_init(libserial_parse_intern_t *cache, unsigned int slots, unsigned int width, void *mem, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_intern
+*	功能:	挂接行驻留缓存, 此后以换行符为终止符的接口返回的文本都在缓存中查找或驻留
+*	参数:	splbuf: 缓冲区  cache: 行驻留缓存(NULL 代表解除挂接)
+*	返回:	无返回值
+*	备注:	只作用于 *_nl 系列接口及其后的 libserial_parse_text_finish(), 
+*			libserial_parse_text_nl() 在拷贝字符的同时计算哈希值, 批量接口在文本结束时计算;
+*			截断的文本和超出槽位长度的文本不驻留
+*---------------------------------------------------------------------*/
+void libserial_parse_set_intern(libserial_parse_buf_t *spbuf, libserial_parse_intern_t *cache);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_intern
+*	功能:	获取上一个返回的文本的驻留编号
+*	参数:	splbuf: 缓冲区  seen: 返回该文本此前是否已驻留(可为 NULL)
+*	返回:	-1: 未挂接驻留缓存、尚未返回文本或文本未驻留  >=0: 驻留编号(小于槽位个数)
+*	备注:	文本驻留期间编号不变; seen 为 0 时该编号对应的文本是新驻留的, 
+*			按编号保存的解码结果需重新生成
+*---------------------------------------------------------------------*/
+int libserial_parse_get_intern(libserial_parse_buf_t *spbuf, int *seen);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_intern_cache
+*	功能:	获取挂接的行驻留缓存
+*	参数:	splbuf: 缓冲区
+*	返回:	NULL: 未挂接行驻留缓存  其他: 行驻留缓存
+*---------------------------------------------------------------------*/
+libserial_parse_intern_t *libserial_parse_get_intern_cache(libserial_parse_buf_t *spbuf);
+#endif
+
 /*---------------------------------------------------------------------
 *	函数: 	libserial_parse_set_shift
 *	功能:	设置大小写字母转换
@@ -94,12 +469,42 @@ void libserial_parse_set_ignore(libserial_parse_buf_t *spbuf, char ignore);
 *---------------------------------------------------------------------*/
 void libserial_parse_set_shift(libserial_parse_buf_t *spbuf, char shift);
 
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_shift_table
+*	功能:	设置用户提供的字符转换表, 可用于大小写以外的字符规整(如将制表符转换为空格)
+*	参数:	splbuf: 缓冲区  table: 256 字节转换表, table[c] 为字符 c 转换后的值(NULL 代表不做转换)
+*	返回:	无返回值
+*	备注:	只保存转换表地址, 解析期间需保持有效; 双引号内的字符不会被转换;
+*			转换在分隔和忽略字符判断之后进行, 转换结果不会再被当作分隔或忽略字符
+*---------------------------------------------------------------------*/
+void libserial_parse_set_shift_table(libserial_parse_buf_t *spbuf, const unsigned char *table);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_escape
+*	功能:	设置是否解码双引号内的转义序列
+*	参数:	splbuf: 缓冲区  escape: 0:不解码(默认) 1:解码
+*	返回:	无返回值
+*	备注:	支持 \n \r \t \xNN, 其余 \c 解码为 c 本身(如 \" 和 \\), 格式错误的 \xNN 被丢弃;
+*			解码得到的字符直接存入文本, 不会被当作双引号、分隔或忽略字符, 也不会被转换;
+*			转义序列中途遇到分隔字符时仍然结束文本; 以换行符为终止符的接口(*_nl)保留双引号, 不解码转义序列
+*---------------------------------------------------------------------*/
+void libserial_parse_set_escape(libserial_parse_buf_t *spbuf, char escape);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_config
+*	功能:	复制另一个解析器的分隔、忽略、大小写转换和转义配置
+*	参数:	splbuf: 缓冲区  src: 已配置好的解析器缓冲区
+*	返回:	无返回值
+*	备注:	不影响缓冲区的解析状态
+*---------------------------------------------------------------------*/
+void libserial_parse_set_config(libserial_parse_buf_t *spbuf, libserial_parse_buf_t *src);
+
 /*---------------------------------------------------------------------
 *	函数: 	libserial_parse_text
 *	功能:	解析以指定符号分隔或跳过的文本
 *	参数:	splbuf: 缓冲区  indata: 输入数据
 *	返回:	0: 正在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
-*	备注:	没有设定分隔符则会一直返回0, 数据超出缓存长度会返回解析完成
+*	备注:	没有设定分隔符则会一直返回0, 数据超出缓存长度会返回解析完成(可通过 libserial_parse_get_status() 区分)
 *---------------------------------------------------------------------*/
 unsigned int libserial_parse_text(libserial_parse_buf_t *spbuf, char indata);
 
@@ -112,6 +517,159 @@ unsigned int libserial_parse_text(libserial_parse_buf_t *spbuf, char indata);
 *---------------------------------------------------------------------*/
 unsigned int libserial_parse_text_nl(libserial_parse_buf_t *spbuf, char indata);
 
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed
+*	功能:	批量解析以指定符号分隔或跳过的文本, 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+*	备注:	解析结果与逐字节调用 libserial_parse_text() 完全一致, 
+*			解析完成时从 data + *used 处继续调用即可
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_nl  (nl -> new line)
+*	功能:	批量解析以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+*	备注:	解析结果与逐字节调用 libserial_parse_text_nl() 完全一致, 
+*			解析完成时从 data + *used 处继续调用即可
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed_nl(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_span
+*	功能:	零拷贝方式批量解析以指定符号分隔或跳过的文本, 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)  span: 返回文本位置
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度
+*	备注:	完整位于数据块内且无需改写(无双引号、忽略字符, 未启用大小写转换)的文本
+*			直接指向 data, 不以 '\0' 结尾; 其余文本指向内部缓冲区 spbuf->buf
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed_span(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used, libserial_parse_span_t *span);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_feed_nl_span  (nl -> new line)
+*	功能:	零拷贝方式批量解析以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 遇到完整文本即停止
+*	参数:	splbuf: 缓冲区  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)  span: 返回文本位置
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度
+*	备注:	完整位于数据块内且未启用大小写转换的文本直接指向 data, 不以 '\0' 结尾;
+*			其余文本指向内部缓冲区 spbuf->buf
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_feed_nl_span(libserial_parse_buf_t *spbuf, const char *data, unsigned int size, unsigned int *used, libserial_parse_span_t *span);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push
+*	功能:	批量解析以指定符号分隔或跳过的文本, 每得到一个文本即在解析循环内调用回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗  	其他: 回调返回的非 0 值, 解析在该文本之后停止
+*	备注:	得到的文本与逐字节调用 libserial_parse_text() 完全一致, 调用者无需逐字节检查返回值;
+*			无需改写的文本直接指向 data(零拷贝), 未结束的文本保留在缓冲区中等待下一个数据块
+*---------------------------------------------------------------------*/
+int libserial_parse_push(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler, const char *data, unsigned int size, unsigned int *used);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push_nl  (nl -> new line)
+*	功能:	批量解析以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 每得到一个文本即在解析循环内调用回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗  	其他: 回调返回的非 0 值, 解析在该文本之后停止
+*	备注:	得到的文本与逐字节调用 libserial_parse_text_nl() 完全一致
+*---------------------------------------------------------------------*/
+int libserial_parse_push_nl(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler, const char *data, unsigned int size, unsigned int *used);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push_finish
+*	功能:	将仍在缓冲区的字符数据作为最后一个文本交给回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调
+*	返回:	0: 没有数据或回调返回 0  	其他: 回调返回的非 0 值
+*	备注:	与 libserial_parse_text_finish() 相同, 用于数据流结束时
+*---------------------------------------------------------------------*/
+int libserial_parse_push_finish(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler);
+
+#ifdef LIBSERIAL_PARSE_IDLE
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_idle
+*	功能:	设置空闲超时时间, 不完整的文本(如没有换行的提示符)超时未收到后续数据时由 libserial_parse_poll() 输出
+*	参数:	splbuf: 缓冲区  timeout: 超时时间(单位与 libserial_parse_poll() 的 now 相同, 0 表示不启用)
+*	返回:	无返回值
+*	备注:	默认不启用
+*---------------------------------------------------------------------*/
+void libserial_parse_set_idle(libserial_parse_buf_t *spbuf, unsigned int timeout);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_set_clock
+*	功能:	挂接时钟回调, 解析接口收到数据时通过它记录最后收到数据的时间
+*	参数:	splbuf: 缓冲区  clock: 时钟回调(NULL 代表解除挂接)  ctx: 回调参数
+*	返回:	无返回值
+*	备注:	每次调用解析接口(包括逐字节接口的每个字符)都会调用一次时钟回调, 
+*			适合以数据块方式输入或时钟读取开销较小的场景; 未挂接时的计时方式见 libserial_parse_poll()
+*---------------------------------------------------------------------*/
+void libserial_parse_set_clock(libserial_parse_buf_t *spbuf, libserial_parse_clock_func_t clock, void *ctx);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_poll
+*	功能:	检查空闲超时, 缓冲区中的不完整文本超时未收到后续数据时将其输出
+*	参数:	splbuf: 缓冲区  now: 当前时间(单位由使用者决定, 如毫秒计数, 允许回绕)
+*	返回:	0: 未超时或没有不完整的文本  	>0: 输出的文本长度, 与 libserial_parse_text_finish() 相同
+*	备注:	挂接了时钟回调时, 最后收到数据的时间由解析接口记录, 文本在超时后的第一次调用时输出;
+*			未挂接时解析接口只标记收到过数据, 其后第一次调用本函数时记录为最后收到数据的时间, 
+*			若只按固定周期 P 调用本函数, 文本在最后一个字节之后 timeout 至 timeout + P 之间输出,
+*			每次输入数据之后调用一次可得到准确的计时; 
+*			没有不完整的文本时(包括只收到过双引号或忽略字符)不改变解析状态
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_poll(libserial_parse_buf_t *spbuf, unsigned int now);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_push_poll
+*	功能:	检查空闲超时, 超时则将不完整的文本交给回调
+*	参数:	splbuf: 缓冲区  handler: 事件回调  now: 当前时间
+*	返回:	0: 未超时、没有数据或回调返回 0  	其他: 回调返回的非 0 值
+*---------------------------------------------------------------------*/
+int libserial_parse_push_poll(libserial_parse_buf_t *spbuf, const libserial_parse_handler_t *handler, unsigned int now);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_idle
+*	功能:	获取距离空闲超时还需等待的时间, 用于设置定时器或事件等待的超时
+*	参数:	splbuf: 缓冲区  now: 当前时间
+*	返回:	0: 未启用或没有不完整的文本  	>0: 还需等待的时间(已超时返回 1)
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_get_idle(libserial_parse_buf_t *spbuf, unsigned int now);
+#endif
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_tokenize
+*	功能:	按解析器的分隔、忽略和大小写配置, 一次性将一行文本原地拆分为多个片段
+*	参数:	splbuf: 提供配置的缓冲区  line: 行文本(原地改写)  size: 行文本长度
+*			argv: 返回片段信息  argc: argv 最多可存储的片段个数
+*	返回:	拆分得到的片段个数, 超出 argc 的部分被丢弃
+*	备注:	规则与逐字节调用 libserial_parse_text() 一致(空片段被跳过), 但双引号内的分隔字符不拆分片段;
+*			不影响缓冲区的解析状态, 每个片段在 line 内以 '\0' 结尾, line 至少需要 size + 1 字节可写空间
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_tokenize(libserial_parse_buf_t *spbuf, char *line, unsigned int size, libserial_parse_token_t *argv, unsigned int argc);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_tokenize_fields
+*	功能:	与 libserial_parse_tokenize() 相同地拆分行文本, 并在同一次扫描中将每个片段转换为数值或键值对
+*	参数:	splbuf: 提供配置的缓冲区  line: 行文本(原地改写)  size: 行文本长度
+*			fields: 返回字段信息  count: fields 最多可存储的字段个数
+*	返回:	拆分得到的字段个数, 超出 count 的部分被丢弃
+*	备注:	支持十进制整数、0x 前缀的十六进制整数和浮点数, 均可带正负号; 不申请内存, 不需要再次扫描片段;
+*			片段内双引号外的第一个 '=' 将片段分为键和值(需不在分隔字符集合内), '=' 之后的空格被跳过
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_tokenize_fields(libserial_parse_buf_t *spbuf, char *line, unsigned int size, libserial_parse_field_t *fields, unsigned int count);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_convert
+*	功能:	将一个文本转换为数值或键值对, 用于逐字节、批量和回调接口得到的文本
+*	参数:	text: 文本(无需 '\0' 结尾)  len: 文本长度  field: 返回字段信息(tok.off 为 0, tok.divide 为 '\0')
+*	返回:	值的数值类型
+*	备注:	规则与 libserial_parse_tokenize_fields() 一致
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_convert(const char *text, unsigned int len, libserial_parse_field_t *field);
+
 /*---------------------------------------------------------------------
 *	函数: 	libserial_parse_finish
 *	功能:	获取当前仍在缓冲区的字符数据
@@ -120,6 +678,128 @@ unsigned int libserial_parse_text_nl(libserial_parse_buf_t *spbuf, char indata);
 *---------------------------------------------------------------------*/
 unsigned int libserial_parse_text_finish(libserial_parse_buf_t *spbuf);
 
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_size
+*	功能:	计算多通道解析器池需要的内存大小(包含内部数据结构所用空间)
+*	参数:	channels: 通道个数  size: 每个通道可用缓冲区大小
+*	返回:	需要的内存字节数
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_size(unsigned int channels, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_create
+*	功能:	使用接口内部申请多通道解析器池, 所有通道共用一块连续内存
+*	参数:	channels: 通道个数  size: 每个通道可用缓冲区大小
+*	返回:	NULL: 申请内存空间失败		>0: 申请成功
+*---------------------------------------------------------------------*/
+libserial_parse_pool_t *libserial_parse_pool_create(unsigned int channels, unsigned int size);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_release
+*	功能:	释放接口内部申请的多通道解析器池
+*	参数:	pool: 由 libserial_parse_pool_create() 创建的多通道解析器池
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_release(libserial_parse_pool_t *pool);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_init
+*	功能:	使用用户提供的或创建接口的内存, 初始化多通道解析器池
+*	参数:	pool: 多通道解析器池
+*	返回:	0: 不满足最小长度要求  >0: 每个通道可存储最长文本的长度 
+*	备注:	默认配置与 libserial_parse_init() 相同, 所有通道共用同一份配置
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_init(libserial_parse_pool_t *pool);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_set_config
+*	功能:	将解析器的分隔、忽略、大小写转换和转义配置应用到所有通道
+*	参数:	pool: 多通道解析器池  spbuf: 已配置好的解析器缓冲区
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_set_config(libserial_parse_pool_t *pool, libserial_parse_buf_t *spbuf);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_text
+*	功能:	获取指定通道的文本缓冲区
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	通道的文本缓冲区, 解析完成后的文本以 '\0' 结尾
+*---------------------------------------------------------------------*/
+char *libserial_parse_pool_text(libserial_parse_pool_t *pool, unsigned int channel);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_reset
+*	功能:	重置指定通道的解析状态
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	无返回值
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_reset(libserial_parse_pool_t *pool, unsigned int channel);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_get_status
+*	功能:	获取指定通道上一个文本的完整状态
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	LIBSERIAL_PARSE_STATUS_OK: 文本完整  LIBSERIAL_PARSE_STATUS_OVERFLOW: 文本因缓冲区已满被截断
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_get_status(libserial_parse_pool_t *pool, unsigned int channel);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_feed
+*	功能:	批量解析指定通道以指定符号分隔或跳过的文本, 遇到完整文本即停止
+*	参数:	pool: 多通道解析器池  channel: 通道号  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+*	备注:	与 libserial_parse_feed() 行为一致, 文本通过 libserial_parse_pool_text() 获取
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_feed(libserial_parse_pool_t *pool, unsigned int channel, const char *data, unsigned int size, unsigned int *used);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_feed_nl  (nl -> new line)
+*	功能:	批量解析指定通道以换行符为终止符的文本(支持 '\n' 和 '\r\n'), 遇到完整文本即停止
+*	参数:	pool: 多通道解析器池  channel: 通道号  data: 输入数据块  size: 数据块长度  
+*			used: 返回已消耗的字节数(可为 NULL)
+*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+*	备注:	与 libserial_parse_feed_nl() 行为一致, 文本通过 libserial_parse_pool_text() 获取
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_feed_nl(libserial_parse_pool_t *pool, unsigned int channel, const char *data, unsigned int size, unsigned int *used);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_finish
+*	功能:	获取指定通道当前仍在缓冲区的字符数据
+*	参数:	pool: 多通道解析器池  channel: 通道号
+*	返回:	0: 没有数据  	>0:剩余字符串长度(不包含 '\0')
+*---------------------------------------------------------------------*/
+unsigned int libserial_parse_pool_finish(libserial_parse_pool_t *pool, unsigned int channel);
+
+#ifdef LIBSERIAL_PARSE_STATS
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_get_stats
+*	功能:	获取解析器的运行统计快照
+*	参数:	splbuf: 缓冲区  stats: 返回运行统计
+*	返回:	无返回值
+*	备注:	可在其他线程调用, 无需停止解析; 解析器正在更新统计时会短暂等待
+*---------------------------------------------------------------------*/
+void libserial_parse_get_stats(libserial_parse_buf_t *spbuf, libserial_parse_stats_t *stats);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_clear_stats
+*	功能:	清除解析器的运行统计
+*	参数:	splbuf: 缓冲区
+*	返回:	无返回值
+*	备注:	仅可在调用解析接口的线程中调用
+*---------------------------------------------------------------------*/
+void libserial_parse_clear_stats(libserial_parse_buf_t *spbuf);
+
+/*---------------------------------------------------------------------
+*	函数: 	libserial_parse_pool_get_stats
+*	功能:	获取多通道解析器池所有通道合计的运行统计快照
+*	参数:	pool: 多通道解析器池  stats: 返回运行统计
+*	返回:	无返回值
+*	备注:	可在其他线程调用, 无需停止解析
+*---------------------------------------------------------------------*/
+void libserial_parse_pool_get_stats(libserial_parse_pool_t *pool, libserial_parse_stats_t *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,384 @@
+﻿/**
+******************************************************************************
+* @文件		libserial_parse_text.hpp
+* @版本		V1.0.2
+* @日期
+* @概要		编译期特化的 C++ 解析器模板(仅头文件, 需要 C++17), 未启用的功能不产生任何运行时判断
+* @作者		lovemengx	email:lovemengx@qq.com
+******************************************************************************
+* @注意  	All rights reserved
+******************************************************************************
+*/
+#ifndef __LIB_SERIAL_PARSE_TEXT_HPP_
+#define __LIB_SERIAL_PARSE_TEXT_HPP_
+
+#include <cstring>
+#include <type_traits>
+#include "libserial_parse_text.h"
+
+namespace libserial_parse {
+
+// 字符集合, 用作分隔字符和忽略字符模板参数, 如 chars<' ', ','>, 空集合 chars<> 表示不忽略任何字符
+template <char... Cs>
+struct chars{
+	static constexpr bool contains(char ch) { return ((ch == Cs) || ... || false); }
+};
+
+// 以换行符为终止符(支持 '\n' 和 '\r\n'), 与 libserial_parse_text_nl() 相同, 不使用忽略字符
+struct newline{};
+
+// 双引号处理方式
+enum class quote_mode{
+	none,		// 双引号作为普通字符(输入不含双引号时与 C 接口一致)
+	strip,		// 移除双引号, 双引号内的字符不被忽略和转换(C 接口的默认行为)
+	escape,		// 在 strip 基础上解码双引号内的转义序列, 与 libserial_parse_set_escape(spbuf, 1) 相同
+};
+
+/*---------------------------------------------------------------------
+*	模板: 	basic_serial_parser
+*	功能:	按模板参数在编译期确定配置的解析器, 输出与相同配置的 C 接口逐字节一致
+*	参数:	Delim: 分隔字符集合 chars<...> 或 newline  Ignore: 忽略字符集合(newline 时不使用)
+*			Shift: LIBSERIAL_PARSE_SHIFT_NORMAL/LOWER/UPPER  QuoteMode: 双引号处理方式
+*			Capacity: 文本缓冲区大小(包含 '\0'), 与 libserial_parse_create() 的 size 及 libserial_parse_init() 的返回值相同
+*	备注:	缓冲区位于对象内部, 不申请内存; 默认参数与 libserial_parse_init() 的默认配置相同
+*---------------------------------------------------------------------*/
+template <class Delim = newline, class Ignore = chars<'\0'>, int Shift = LIBSERIAL_PARSE_SHIFT_NORMAL,
+		  quote_mode QuoteMode = quote_mode::strip, unsigned int Capacity = 256>
+class basic_serial_parser{
+	static_assert(Capacity >= 2, "Capacity must hold at least one character and '\\0'");
+	static_assert(Shift >= LIBSERIAL_PARSE_SHIFT_NORMAL && Shift <= LIBSERIAL_PARSE_SHIFT_UPPER, "Shift must be NORMAL, LOWER or UPPER");
+
+public:
+	static constexpr bool nl = std::is_same<Delim, newline>::value;		// 是否按行解析
+	static constexpr unsigned int capacity = Capacity;
+
+	/*---------------------------------------------------------------------
+	*	函数: 	text
+	*	功能:	逐字节解析, 与 libserial_parse_text() 或 libserial_parse_text_nl() 相同
+	*	参数:	indata: 输入数据
+	*	返回:	0: 正在解析  	>0:解析完成, 返回文本长度(不包含 '\0')
+	*---------------------------------------------------------------------*/
+	unsigned int text(char indata)
+	{
+		if constexpr (nl){
+			return text_nl_byte(indata);
+		}else{
+			return text_byte(indata);
+		}
+	}
+
+	/*---------------------------------------------------------------------
+	*	函数: 	feed
+	*	功能:	批量解析数据块, 得到一个文本即返回, 与 libserial_parse_feed() 或 libserial_parse_feed_nl() 相同
+	*	参数:	data: 输入数据块  size: 数据块长度  used: 返回已消耗的字节数(可为 nullptr)
+	*	返回:	0: 数据块已全部消耗且仍在解析  	>0:解析成功, 返回文本长度(不包含 '\0')
+	*---------------------------------------------------------------------*/
+	unsigned int feed(const char *data, unsigned int size, unsigned int *used)
+	{
+		unsigned int i = 0x00, n = 0x00, len = 0x00;
+
+		while(i < size && 0 == len){
+			// 快速路径: 批量拷贝不含特殊字符的数据
+			if((n = scan(data + i, room(size - i))) > 0){
+				len = copy_run(data + i, n);
+				i += n;
+				continue;
+			}
+
+			// 特殊字符逐字节处理
+			len = text(data[i++]);
+		}
+
+		if(used){
+			*used = i;
+		}
+		return len;
+	}
+
+	/*---------------------------------------------------------------------
+	*	函数: 	finish
+	*	功能:	获取当前仍在缓冲区的字符数据, 与 libserial_parse_text_finish() 相同
+	*	返回:	0: 没有数据  	>0:剩余字符串长度(不包含 '\0')
+	*---------------------------------------------------------------------*/
+	unsigned int finish()
+	{
+		end_ = '\0';
+		return finish_text();
+	}
+
+	/*---------------------------------------------------------------------
+	*	函数: 	reset
+	*	功能:	丢弃正在解析的文本并清除状态, 与 libserial_parse_reset_buf() 相同
+	*---------------------------------------------------------------------*/
+	void reset()
+	{
+		idx_ = len_ = 0x00;
+		dqu_ = ovf_ = false;
+		esc_ = hex_ = 0x00;
+		end_ = '\0';
+		buf_[0] = '\0';
+	}
+
+	const char *buf() const { return buf_; }				// 文本地址, 以 '\0' 结尾
+	char divide() const { return end_; }					// 结束上一个文本的分隔字符, 同 libserial_parse_get_divide()
+	unsigned int status() const { return ovf_ ? LIBSERIAL_PARSE_STATUS_OVERFLOW : LIBSERIAL_PARSE_STATUS_OK; }
+
+private:
+	// 转义序列解码状态, 与 C 接口相同
+	enum : unsigned char { ESC_NONE, ESC_START, ESC_HEX1, ESC_HEX2 };
+
+	static constexpr bool quote = (QuoteMode != quote_mode::none);
+	static constexpr bool escape = (QuoteMode == quote_mode::escape) && !nl;
+
+	// 按行解析时双引号只影响大小写转换
+	static constexpr bool track_dqu = quote && !(nl && LIBSERIAL_PARSE_SHIFT_NORMAL == Shift);
+
+	static constexpr char shift(char ch)
+	{
+		if constexpr (LIBSERIAL_PARSE_SHIFT_LOWER == Shift){
+			return (ch >= 'A' && ch <= 'Z') ? (char)(ch + 0x20) : ch;
+		}else if constexpr (LIBSERIAL_PARSE_SHIFT_UPPER == Shift){
+			return (ch >= 'a' && ch <= 'z') ? (char)(ch - 0x20) : ch;
+		}else{
+			return ch;
+		}
+	}
+
+	// 批量拷贝需要停下的字符
+	static constexpr bool is_stop(char ch)
+	{
+		if constexpr (nl){
+			return '\n' == ch || (track_dqu && '\"' == ch);
+		}else{
+			return Delim::contains(ch) || Ignore::contains(ch) || (quote && '\"' == ch) || (escape && '\\' == ch);
+		}
+	}
+
+	static int hex(char ch)
+	{
+		if(ch >= '0' && ch <= '9'){
+			return ch - '0';
+		}
+		if((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f'){
+			return (ch | 0x20) - 'a' + 10;
+		}
+		return -1;
+	}
+
+	// libserial_parse_shift_convert(): 双引号内的字符不进行转换
+	char shift_convert(char indata) const
+	{
+		if constexpr (LIBSERIAL_PARSE_SHIFT_NORMAL == Shift){
+			return indata;
+		}else if constexpr (quote){
+			return dqu_ ? indata : shift(indata);
+		}else{
+			return shift(indata);
+		}
+	}
+
+	// libserial_parse_preprocess(): 移除双引号、忽略字符和前置空格
+	bool preprocess(char indata)
+	{
+		if constexpr (quote){
+			if('\"' == indata){
+				dqu_ = !dqu_;
+				return true;
+			}
+			if(!dqu_ && Ignore::contains(indata)){
+				return true;
+			}
+		}else{
+			if(Ignore::contains(indata)){
+				return true;
+			}
+		}
+		return (0 == idx_ && ' ' == indata);
+	}
+
+	// libserial_parse_escape(): 0: 尚未解码完成  1: 解码完成  2: 格式错误的 \x 转义被丢弃
+	int decode(char *indata)
+	{
+		int val = 0x00;
+
+		switch(esc_){
+		case ESC_NONE:
+			esc_ = ESC_START;
+			return 0;
+		case ESC_START:
+			esc_ = ESC_NONE;
+			switch(*indata){
+			case 'n':	*indata = '\n';	break;
+			case 'r':	*indata = '\r';	break;
+			case 't':	*indata = '\t';	break;
+			case 'x':	esc_ = ESC_HEX1;	return 0;
+			default:	break;
+			}
+			return 1;
+		case ESC_HEX1:
+			if((val = hex(*indata)) < 0){
+				esc_ = ESC_NONE;
+				return 2;
+			}
+			hex_ = (unsigned char)val;
+			esc_ = ESC_HEX2;
+			return 0;
+		default:
+			esc_ = ESC_NONE;
+			if((val = hex(*indata)) < 0){
+				return 2;
+			}
+			*indata = (char)((hex_ << 4) | val);
+			return 1;
+		}
+	}
+
+	// 文本结束, 清除状态并返回文本长度
+	unsigned int finish_text()
+	{
+		ovf_ = false;
+		len_ = idx_;
+		idx_ = 0x00;
+		dqu_ = false;
+		esc_ = ESC_NONE;
+		return len_;
+	}
+
+	// libserial_parse_overflow(): 缓冲区已满, 截断的文本作为一个文本返回
+	unsigned int overflow()
+	{
+		end_ = '\0';
+		ovf_ = true;
+		idx_ = 0x00;
+		dqu_ = false;
+		esc_ = ESC_NONE;
+		return len_;
+	}
+
+	// libserial_parse_store(): 复制数据并检查长度
+	unsigned int store(char indata)
+	{
+		buf_[idx_ + 1] = '\0';
+		buf_[idx_++] = indata;
+		len_ = idx_;
+		return (idx_ >= Capacity - 1) ? overflow() : 0;
+	}
+
+	// libserial_parse_text_byte()
+	unsigned int text_byte(char indata)
+	{
+		// 双引号内的转义序列, 解码得到的字符直接存储(分隔字符仍然结束文本)
+		if constexpr (escape){
+			if((esc_ || ('\\' == indata && dqu_)) && !Delim::contains(indata)){
+				switch(decode(&indata)){
+				case 0:
+					return 0;
+				case 1:
+					return store(indata);
+				default:
+					break;
+				}
+			}
+		}
+
+		// 对数据进行预处理
+		if(preprocess(indata)){
+			return 0;
+		}
+
+		// 匹配分隔符
+		if(Delim::contains(indata)){
+			end_ = indata;
+			return finish_text();
+		}
+
+		// 大小写转换, 复制数据并检查长度
+		return store(shift_convert(indata));
+	}
+
+	// libserial_parse_text_nl_byte()
+	unsigned int text_nl_byte(char indata)
+	{
+		// 检查换行字符
+		if('\n' == indata){
+			if(idx_ && '\r' == buf_[idx_ - 1]){
+				buf_[--idx_] = '\0';
+			}
+			end_ = '\n';
+			return finish_text();
+		}
+
+		// 双引号保留在文本中, 只标记转换状态
+		if constexpr (track_dqu){
+			if('\"' == indata){
+				dqu_ = !dqu_;
+			}
+		}
+
+		return store(shift_convert(indata));
+	}
+
+	// libserial_parse_room(): 本次最多可批量拷贝的字节数, 文本开头(需移除前置空格)和转义序列中为 0
+	unsigned int room(unsigned int size) const
+	{
+		unsigned int n = Capacity - 1 - idx_;
+
+		if constexpr (!nl){
+			if(0 == idx_ || esc_){
+				return 0;
+			}
+		}
+		return (size < n) ? size : n;
+	}
+
+	// 扫描不含停止字符的数据长度
+	static unsigned int scan(const char *data, unsigned int size)
+	{
+		unsigned int n = 0x00;
+
+		if constexpr (nl && !track_dqu){
+			const char *end = (const char *)std::memchr(data, '\n', size);
+			return end ? (unsigned int)(end - data) : size;
+		}else{
+			while(n < size && !is_stop(data[n])){
+				n++;
+			}
+			return n;
+		}
+	}
+
+	// libserial_parse_copy_run(): 批量拷贝数据并检查长度
+	unsigned int copy_run(const char *data, unsigned int size)
+	{
+		unsigned int i = 0x00;
+
+		if constexpr (LIBSERIAL_PARSE_SHIFT_NORMAL == Shift){
+			std::memcpy(buf_ + idx_, data, size);
+		}else{
+			for(i = 0; i < size; i++){
+				buf_[idx_ + i] = shift_convert(data[i]);
+			}
+		}
+		idx_ += size;
+		buf_[idx_] = '\0';
+		len_ = idx_;
+		return (idx_ >= Capacity - 1) ? overflow() : 0;
+	}
+
+	char buf_[Capacity] = {};		// 文本缓冲区
+	unsigned int idx_ = 0x00;		// 存储数据的索引
+	unsigned int len_ = 0x00;		// 上一个文本的长度
+	bool dqu_ = false;				// 双引号处理
+	bool ovf_ = false;				// 上一个文本因缓冲区已满被截断
+	unsigned char esc_ = 0x00;		// 转义序列解码状态
+	unsigned char hex_ = 0x00;		// \xNN 转义已读到的第一个十六进制数字
+	char end_ = '\0';				// 结束上一个文本的分隔字符
+};
+
+// 以换行符为终止符的解析器, 与 libserial_parse_text_nl() 的默认配置相同
+template <unsigned int Capacity = 256>
+using serial_line_parser = basic_serial_parser<newline, chars<'\0'>, LIBSERIAL_PARSE_SHIFT_NORMAL, quote_mode::strip, Capacity>;
+
+}
+
+#endif